@@ -36,8 +36,13 @@
 #ifndef AUDIO_HDI_COMMON_H
 #define AUDIO_HDI_COMMON_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <gtest/gtest.h>
 #include "audio_adapter.h"
+#include "audio_hdi_pcm_synth.h"
+#include "audio_hdi_pcm_verify.h"
 #include "audio_internal.h"
 #include "audio_types.h"
 #include "hdf_io_service_if.h"
@@ -53,6 +58,7 @@ namespace Audio {
 #ifdef AUDIO_MPI_SO
     const std::string FUNCTION_NAME = "GetAudioManagerFuncs";
     const std::string RESOLVED_PATH = HDF_LIBRARY_FULL_PATH("libhdi_audio");
+    const std::string SDK_RESOLVED_PATH = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
     const int IS_ADM = false;
 #endif
 #ifdef AUDIO_ADM_SERVICE
@@ -84,6 +90,8 @@ namespace Audio {
 const std::string ADAPTER_NAME = "primary";
 const std::string ADAPTER_NAME_OUT = "primary_ext";
 using TestAudioManager = struct AudioManager;
+using GetAudioManagerFunc = TestAudioManager *(*)();
+const char * const HAL_LIBRARY_ENV = "AUDIO_HAL_LIBRARY";
 const std::string AUDIO_RIFF = "RIFF";
 const std::string AUDIO_WAVE = "WAVE";
 const std::string AUDIO_DATA = "data";
@@ -98,7 +106,11 @@ const float GAIN_MIN = 0;
 const float GAIN_MAX = 15;
 const uint64_t INITIAL_VALUE = 0;
 const int BUFFER_LENTH = 1024 * 16;
+const int RECORD_RING_DEPTH = 4;
+const size_t RECORD_BUFFER_ALIGN = 4096;
 const int FILE_CAPTURE_SIZE = 1024 * 1024 * 1;
+const int MMAP_POLL_INTERVAL_US = 2000;
+const uint32_t RENDER_EVENT_QUEUE_DEPTH = 256;
 const uint64_t MEGABYTE = 1024;
 const int FRAME_SIZE = 1024;
 const int FRAME_COUNT = 4;
@@ -114,6 +126,7 @@ const int RANGE = 3;
 const std::string HDF_CONTROL_SERVICE = "hdf_audio_control";
 const std::string HDF_RENDER_SERVICE = "hdf_audio_render";
 const std::string HDF_CAPTURE_SERVICE = "hdf_audio_capture";
+const int CONTROL_SBUF_POOL_SIZE = 4;
 
 const int AUDIODRV_CTL_ELEM_IFACE_DAC = 0; /* virtual dac device */
 const int AUDIODRV_CTL_ELEM_IFACE_ADC = 1; /* virtual adc device */
@@ -130,6 +143,12 @@ enum ControlDispMethodCmd {
     AUDIODRV_CTRL_IOCTRL_ELEM_BUTT,
 };
 
+enum AudioRenderSource {
+    AUDIO_SOURCE_FILE = 0, /* stdio reads into a heap frame */
+    AUDIO_SOURCE_MMAP = 1, /* frames are handed to RenderFrame straight from the file mapping */
+    AUDIO_SOURCE_SYNTH = 2, /* frames are generated in memory, the wav file is not read */
+};
+
 enum AudioPCMBit {
     PCM_8_BIT  = 8,
     PCM_16_BIT = 16,
@@ -148,6 +167,34 @@ struct AudioCtlElemValue {
     int32_t value[2];
 };
 
+/* one binding to the control service reused by consecutive register reads and writes */
+struct AudioControlSession {
+    struct HdfIoService *service;
+    struct HdfSBuf *sBufPool[CONTROL_SBUF_POOL_SIZE];
+    int pooled;
+};
+
+/* a pooled stream and the mute, volume and gain it reported right after creation */
+struct AudioPooledStream {
+    struct AudioAdapter *adapter;
+    struct AudioRender *render;
+    struct AudioCapture *capture;
+    bool inUse;
+    bool hasBaseline;
+    bool mute;
+    float volume;
+    float gain;
+};
+
+/* per-suite pool owned by SetUpTestCase: one warm render and one warm capture, reset before each hand-out */
+struct AudioStreamPool {
+    TestAudioManager *manager;
+    struct AudioPooledStream render;
+    struct AudioPooledStream capture;
+    uint32_t created;
+    uint32_t reused;
+};
+
 struct AudioHeadInfo {
     uint32_t testFileRiffId;
     uint32_t testFileRiffSize;
@@ -164,6 +211,58 @@ struct AudioHeadInfo {
     uint32_t dataSize;
 };
 
+struct AudioWavMapping {
+    uint8_t *base;
+    size_t length;
+    const uint8_t *data;
+    uint64_t dataSize;
+};
+
+struct AudioPcmFixture {
+    struct AudioHeadInfo headInfo;
+    struct AudioSampleAttributes attrs; /* attributes parsed from the wav head */
+    const char *frame;                  /* first period of the data chunk, shared and read-only */
+    uint64_t frameSize;
+};
+
+struct AudioRecordStats {
+    uint64_t capturedBytes;
+    uint64_t writtenBytes;
+    uint64_t overruns;    /* periods dropped because the writer still held every ring slot */
+    uint64_t droppedBytes; /* captured bytes of those periods, never written */
+    uint64_t writeErrors;
+    bool directIo;        /* the writer bypassed the page cache with O_DIRECT */
+    struct AudioPcmStats pcm; /* content of every captured period, empty if the attributes were unavailable */
+};
+
+struct AudioMmapStreamStats {
+    uint64_t frames;        /* final hardware position */
+    uint64_t polls;
+    uint64_t stalls;        /* times the position held still for longer than one transfer period */
+    int64_t elapsedNs;      /* from the first position movement to the end of the buffer */
+    double bytesPerSecond;
+    double driftPpm;        /* position rate against the nominal sample rate */
+    int64_t maxLagNs;       /* largest distance of the position from a nominal clock started at first movement */
+};
+
+struct AudioRenderEvent {
+    enum AudioCallbackType type;
+    int64_t timestampNs;
+};
+
+/*
+ * lock-free ring from the HAL callback thread to one consumer; pass it as the RegCallback cookie. The mutex only
+ * orders the wake-up after a push against a consumer that is about to block in RenderEventQueueWait
+ */
+struct AudioRenderEventQueue {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint64_t> dropped;
+    struct AudioRenderEvent events[RENDER_EVENT_QUEUE_DEPTH];
+    std::mutex mutex;
+    std::condition_variable pushed;
+};
+
 struct AudioCharacteristic {
     bool setmute;
     bool getmute;
@@ -216,10 +315,14 @@ struct PrepareAudioPara {
     int64_t totalTime;
     float averageDelayTime;
     struct AudioDeviceDescriptor devDesc;
+    enum AudioRenderSource source;
+    struct AudioRecordStats recordStats;
 };
 
 int32_t InitAttrs(struct AudioSampleAttributes &attrs);
 
+int64_t GetMonotonicNs();
+
 int32_t InitDevDesc(struct AudioDeviceDescriptor &devDesc, const uint32_t portId, enum AudioPortPin pins);
 
 int32_t SwitchAdapter(struct AudioAdapterDescriptor *descs, const std::string &adapterNameCase,
@@ -229,13 +332,34 @@ uint32_t PcmFormatToBits(enum AudioFormat format);
 
 uint32_t PcmFramesToBytes(const struct AudioSampleAttributes attrs);
 
+int32_t WavHeadCheck(const struct AudioHeadInfo &wavHeadInfo, struct AudioSampleAttributes &attrs);
+
 int32_t WavHeadAnalysis(struct AudioHeadInfo &wavHeadInfo, FILE *file, struct AudioSampleAttributes &attrs);
 
+int32_t WavMapOpen(const char *path, struct AudioWavMapping &mapping, struct AudioHeadInfo &wavHeadInfo,
+    struct AudioSampleAttributes &attrs);
+
+void WavMapClose(struct AudioWavMapping &mapping);
+
 int32_t GetAdapters(TestAudioManager *manager, struct AudioAdapterDescriptor **descs, int &size);
 
 int32_t GetLoadAdapter(TestAudioManager *manager, enum AudioPortDirection portType,
     const std::string &adapterName, struct AudioAdapter **adapter, struct AudioPort *&audioPort);
 
+/* pairs with GetLoadAdapter, AudioCreateRender and AudioCreateCapture; other adapters go to the driver as is */
+void ReleaseLoadAdapter(TestAudioManager *manager, struct AudioAdapter *adapter);
+
+GetAudioManagerFunc AudioLoaderGetManagerFunc();
+
+/* true when AUDIO_HAL_LIBRARY loaded a stand-in HAL, whose captures hear the renders on the same adapter */
+bool AudioLoaderOverridden();
+
+int32_t AdapterCacheRetain(TestAudioManager *manager, bool retain);
+
+void AdapterCacheRelease(TestAudioManager *manager);
+
+void AdapterCacheCounts(TestAudioManager *manager, uint32_t &adapters, uint32_t &references);
+
 int32_t AudioCreateRender(TestAudioManager *manager, enum AudioPortPin pins, const std::string &adapterName,
     struct AudioAdapter **adapter, struct AudioRender **render);
 
@@ -245,18 +369,60 @@ int32_t AudioCreateCapture(TestAudioManager *manager, enum AudioPortPin pins, co
 int32_t FrameStart(struct AudioHeadInfo wavHeadInfo, struct AudioRender *render, FILE *file,
     struct AudioSampleAttributes attrs);
 
+int32_t FrameStartMmap(struct AudioRender *render, const struct AudioWavMapping &mapping,
+    struct AudioSampleAttributes attrs);
+
+int32_t FrameStartSynth(struct AudioRender *render, struct AudioPcmSynth &synth, struct AudioSampleAttributes attrs,
+    uint64_t frames);
+
 int32_t FrameStartCapture(struct AudioCapture *capture, FILE *file, const struct AudioSampleAttributes attrs);
 
+int32_t FrameStartCaptureVerify(struct AudioCapture *capture, FILE *file, const struct AudioSampleAttributes attrs,
+    struct AudioPcmStats &pcmStats);
+
+/* plays the reference tone on render and verifies frames of it captured by capture against SYNTH_TONE_HZ */
+int32_t CaptureToneVerify(struct AudioRender *render, struct AudioCapture *capture, uint64_t frames,
+    struct AudioPcmStats &stats);
+
+/* AUDIO_SOURCE_SYNTH in the environment swaps every wav fixture except the mapped one for the generator */
+bool SynthSourceForced();
+
+int32_t GetPcmFixture(const std::string &path, const struct AudioSampleAttributes &attrs,
+    const struct AudioPcmFixture *&fixture);
+
 int32_t RenderFramePrepare(const std::string &path, char *&frame, uint64_t &numRead);
 
 void FrameStatus(int status);
 
 int32_t StartRecord(struct AudioCapture *capture, FILE *file, uint64_t filesize);
 
+int32_t StartRecordPipeline(struct AudioCapture *capture, FILE *file, uint64_t filesize,
+    struct AudioRecordStats &stats);
+
+void RecordStatsPrint(const char *label, const struct AudioRecordStats &stats);
+
 int32_t WriteIdToBuf(struct HdfSBuf *sBuf, struct AudioCtlElemId id);
 
 int32_t WriteEleValueToBuf(struct HdfSBuf *sBuf, struct AudioCtlElemValue elemvalue);
 
+int32_t ControlSessionOpen(struct AudioControlSession &session);
+
+void ControlSessionClose(struct AudioControlSession &session);
+
+int32_t ControlSessionWrite(struct AudioControlSession &session, const struct AudioCtlElemValue &elemValue);
+
+int32_t ControlSessionWriteBatch(struct AudioControlSession &session, const struct AudioCtlElemValue *elemValues,
+    uint32_t count);
+
+int32_t ControlSessionRead(struct AudioControlSession &session, const struct AudioCtlElemId &id,
+    struct AudioCtlElemValue &elemValue);
+
+void ReleaseControlSession();
+
+int32_t ChangeRegisterStatus(struct AudioCtlElemValue elemValue);
+
+int32_t QueryRegisterStatus(struct AudioCtlElemId id, struct AudioCtlElemValue &elemValue);
+
 int32_t PowerOff(struct AudioCtlElemValue firstElemValue, struct AudioCtlElemValue secondElemValue);
 
 int32_t CheckRegisterStatus(const struct AudioCtlElemId firstId, const struct AudioCtlElemId secondId,
@@ -276,6 +442,23 @@ int32_t AudioCreateStartCapture(TestAudioManager *manager, struct AudioCapture *
 
 int32_t AudioCaptureStartAndOneFrame(struct AudioCapture *capture);
 
+void StreamPoolInit(struct AudioStreamPool &pool, TestAudioManager *manager);
+
+int32_t StreamPoolAcquireRender(struct AudioStreamPool &pool, struct AudioAdapter **adapter,
+    struct AudioRender **render);
+
+int32_t StreamPoolAcquireCapture(struct AudioStreamPool &pool, struct AudioAdapter **adapter,
+    struct AudioCapture **capture);
+
+void StreamPoolReleaseRender(struct AudioStreamPool &pool, struct AudioAdapter *adapter, struct AudioRender *render);
+
+void StreamPoolReleaseCapture(struct AudioStreamPool &pool, struct AudioAdapter *adapter,
+    struct AudioCapture *capture);
+
+void StreamPoolReclaim(struct AudioStreamPool &pool);
+
+void StreamPoolDeinit(struct AudioStreamPool &pool);
+
 int32_t PlayAudioFile(struct PrepareAudioPara &audiopara);
 
 int32_t RecordAudio(struct PrepareAudioPara &audiopara);
@@ -294,7 +477,17 @@ int32_t InitMmapDesc(FILE *fp, struct AudioMmapBufferDescripter &desc, int32_t &
 int32_t PlayMapAudioFile(struct PrepareAudioPara &audiopara);
 
 int32_t RecordMapAudio(struct PrepareAudioPara &audiopara);
+
+int32_t PlayMmapStream(struct PrepareAudioPara &audiopara, struct AudioMmapStreamStats &stats);
+
+int32_t RecordMmapStream(struct PrepareAudioPara &audiopara, struct AudioMmapStreamStats &stats);
 int32_t AudioRenderCallback(enum AudioCallbackType type, void *reserved, void *cookie);
+int32_t AudioRenderEventCallback(enum AudioCallbackType type, void *reserved, void *cookie);
+/* only before the queue is handed to RegCallback; a registered queue may be pushed to at any time */
+void RenderEventQueueInit(struct AudioRenderEventQueue &queue);
+bool RenderEventQueuePop(struct AudioRenderEventQueue &queue, struct AudioRenderEvent &event);
+/* blocks until an event is queued or GetMonotonicNs passes deadlineNs; false on the deadline */
+bool RenderEventQueueWait(struct AudioRenderEventQueue &queue, int64_t deadlineNs);
 int32_t CheckFlushValue();
 int32_t CheckRenderFullValue();
 int32_t CheckWriteCompleteValue();
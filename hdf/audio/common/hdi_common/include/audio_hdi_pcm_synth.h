@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_pcm_synth.h
+ *
+ * @brief Declares the synthetic PCM generator used in place of the on-device wav fixtures.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef AUDIO_HDI_PCM_SYNTH_H
+#define AUDIO_HDI_PCM_SYNTH_H
+
+#include <cstddef>
+#include <cstdint>
+#include "audio_types.h"
+
+namespace HMOS {
+namespace Audio {
+const double SYNTH_AMPLITUDE = 0.5;
+const double SYNTH_TONE_HZ = 1000.0;
+const double SYNTH_SWEEP_START_HZ = 20.0;
+const double SYNTH_SWEEP_END_HZ = 20000.0;
+const double SYNTH_SWEEP_SECONDS = 1.0;
+const uint32_t SYNTH_PLAY_SECONDS = 10;
+const uint32_t SYNTH_NOISE_LANES = 8;
+
+enum AudioSynthSignal {
+    AUDIO_SYNTH_SILENCE = 0,
+    AUDIO_SYNTH_SWEEP = 1,   /* logarithmic sine sweep, a steady tone if both ends are equal */
+    AUDIO_SYNTH_NOISE = 2,   /* uniform white noise, independent per channel */
+    AUDIO_SYNTH_IMPULSE = 3, /* single non-zero frames, impulsePeriod frames apart */
+};
+
+struct AudioSynthParams {
+    enum AudioSynthSignal signal;
+    double amplitude;        /* fraction of full scale, 0..1 */
+    double startHz;
+    double endHz;            /* clamped below Nyquist */
+    double sweepSeconds;     /* length of one sweep, it restarts from startHz afterwards */
+    uint32_t impulsePeriod;  /* frames between impulses */
+    uint32_t seed;
+};
+
+/* generator state; every PcmSynthFill continues the signal where the previous one stopped */
+struct AudioPcmSynth {
+    struct AudioSynthParams params;
+    uint32_t bits;
+    uint32_t channelCount;
+    uint32_t sampleRate;
+    uint64_t frames;
+    uint64_t sweepFrames;
+    uint64_t sweepPosition;
+    double frequency;
+    double sweepRatio;       /* per-frame frequency multiplier of the sweep */
+    double phaseCos;
+    double phaseSin;
+    uint32_t noise[SYNTH_NOISE_LANES];
+};
+
+/* AUDIO_SYNTH_SWEEP covers the audible band; pass SYNTH_TONE_HZ for both ends for a reference tone */
+void PcmSynthDefault(struct AudioSynthParams &params, enum AudioSynthSignal signal);
+
+int32_t PcmSynthInit(struct AudioPcmSynth &synth, const struct AudioSampleAttributes &attrs,
+    const struct AudioSynthParams &params);
+
+/* fills whole frames only; returns the number of bytes written */
+size_t PcmSynthFill(struct AudioPcmSynth &synth, void *data, size_t length);
+}
+}
+#endif // AUDIO_HDI_PCM_SYNTH_H
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_pcm_verify.h
+ *
+ * @brief Declares the streaming PCM content verifier run on captured buffers.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef AUDIO_HDI_PCM_VERIFY_H
+#define AUDIO_HDI_PCM_VERIFY_H
+
+#include <cstddef>
+#include <cstdint>
+#include "audio_types.h"
+
+namespace HMOS {
+namespace Audio {
+const uint32_t ENVELOPE_BLOCKS_PER_SECOND = 500; /* 2ms blocks, two periods of the 1kHz reference tone */
+/* a half-scale tone ramped over the full range every 250ms moves about 0.005 per block when the gain is smoothed */
+const double ZIPPER_STEP_LIMIT = 0.02;
+
+/* levels are normalized to full scale, so 1.0 is the largest magnitude of any format */
+struct AudioPcmStats {
+    uint64_t samples;
+    double rms;
+    double peak;
+    double dcOffset;
+    uint64_t longestZeroRun; /* longest run of consecutive zero samples, across buffer boundaries */
+    double correlation;      /* 0..1 match of the channel mix against the reference tone, 0 if none was set */
+};
+
+struct AudioPcmVerifyLimits {
+    double minRms;
+    double maxDcOffset;
+    uint64_t maxZeroRun;
+    double minCorrelation;
+};
+
+/* accumulated state; feed every buffer of a stream through PcmVerifyFeed and read it back with PcmVerifyResult */
+struct AudioPcmVerifier {
+    uint32_t bits;
+    uint32_t channelCount;
+    uint64_t samples;
+    int64_t integerSum;       /* 16-bit path keeps exact integer sums */
+    uint64_t integerSumSquare;
+    double sum;
+    double sumSquare;
+    double peak;
+    uint64_t zeroRun;
+    uint64_t longestZeroRun;
+    double toneCos;
+    double toneSin;
+    double stepCos;
+    double stepSin;
+    double toneInPhase;
+    double toneQuadrature;
+    double mixSum;
+    double mixSumSquare;
+    uint64_t frames;
+};
+
+struct AudioEnvelopeStats {
+    uint64_t blocks;
+    uint64_t zipperSteps; /* block-to-block envelope steps larger than the limit */
+    double maxStep;
+    double minLevel;
+    double maxLevel;
+};
+
+/* peak envelope over fixed blocks of frames; a gain change applied without smoothing shows as a step in it */
+struct AudioPcmEnvelope {
+    uint32_t bits;
+    uint32_t blockSamples;
+    uint32_t blockFill;
+    double stepLimit;
+    double blockPeak;
+    double lastPeak;
+    struct AudioEnvelopeStats stats;
+};
+
+int32_t PcmVerifyInit(struct AudioPcmVerifier &verifier, const struct AudioSampleAttributes &attrs,
+    double referenceHz);
+
+void PcmVerifyFeed(struct AudioPcmVerifier &verifier, const void *data, size_t length);
+
+void PcmVerifyResult(const struct AudioPcmVerifier &verifier, struct AudioPcmStats &stats);
+
+int32_t PcmVerifyCheck(const struct AudioPcmStats &stats, const struct AudioPcmVerifyLimits &limits);
+
+void PcmStatsPrint(const char *label, const struct AudioPcmStats &stats);
+
+/* blockFrames of 0 uses ENVELOPE_BLOCKS_PER_SECOND blocks */
+int32_t PcmEnvelopeInit(struct AudioPcmEnvelope &envelope, const struct AudioSampleAttributes &attrs,
+    uint32_t blockFrames, double stepLimit);
+
+void PcmEnvelopeFeed(struct AudioPcmEnvelope &envelope, const void *data, size_t length);
+
+void PcmEnvelopeResult(const struct AudioPcmEnvelope &envelope, struct AudioEnvelopeStats &stats);
+}
+}
+#endif // AUDIO_HDI_PCM_VERIFY_H
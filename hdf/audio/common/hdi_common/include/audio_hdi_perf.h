@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_perf.h
+ *
+ * @brief Declares the latency histogram and timed frame loops used by the audio benchmark suites.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef AUDIO_HDI_PERF_H
+#define AUDIO_HDI_PERF_H
+
+#include <vector>
+#include "audio_hdi_common.h"
+
+namespace HMOS {
+namespace Audio {
+/* log-linear buckets: 2^7 sub-buckets per power of two keep every bucket within ~1% of its value */
+const int LATENCY_SUB_BUCKET_BITS = 7;
+const int LATENCY_SUB_BUCKET_COUNT = 1 << LATENCY_SUB_BUCKET_BITS;
+const int LATENCY_MAX_MAGNITUDE = 40; /* 2^40 ns, about 18 minutes */
+const int LATENCY_BUCKET_COUNT = LATENCY_SUB_BUCKET_COUNT * (LATENCY_MAX_MAGNITUDE - LATENCY_SUB_BUCKET_BITS + 2);
+const int64_t NSEC_PER_USEC = 1000;
+const int64_t NSEC_PER_MSEC = 1000000;
+const double PERCENTILE_50 = 50.0;
+const double PERCENTILE_99 = 99.0;
+const double PERCENTILE_999 = 99.9;
+const uint32_t BENCHMARK_FRAME_COUNT = 200;
+const uint32_t STRESS_DURATION_MS = 10000;
+const uint32_t STRESS_MAX_STREAMS = 8;
+const uint32_t NONBLOCK_MAX_OUTSTANDING = 2;
+const int64_t NONBLOCK_EVENT_TIMEOUT_NS = 500000000;
+const uint32_t SOAK_DURATION_MS = 60000; /* overridden by AUDIO_SOAK_DURATION_MS for hours-long runs */
+const uint32_t SOAK_CYCLE_MS = 5000;
+const uint32_t SOAK_SAMPLE_INTERVAL_MS = 1000;
+const uint32_t SOAK_FD_TOLERANCE = 2;
+const uint32_t POSITION_ANALYZE_MS = 2000;
+const int POSITION_SAMPLE_INTERVAL_US = 200;
+const uint32_t SCENE_SWITCH_COUNT = 8;
+const uint32_t SCENE_DWELL_MS = 250; /* position watched before the first switch and after each one */
+const int64_t SCENE_GLITCH_TOLERANCE_NS = 20000000;
+const enum AudioPortPin SCENE_RENDER_PINS[] = { PIN_OUT_SPEAKER, PIN_OUT_HEADSET };
+const enum AudioPortPin SCENE_CAPTURE_PINS[] = { PIN_IN_MIC, PIN_IN_HS_MIC };
+const uint32_t RAMP_RATE_HZ = 2000;
+const uint32_t RAMP_PERIOD_MS = 500; /* one low-high-low triangle */
+const uint32_t RAMP_DURATION_MS = 3000;
+const uint32_t RAMP_LEAD_MS = 500;   /* stream running before the first update and after the last one */
+const enum AudioFormat ATTR_SWEEP_FORMATS[] = { AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_24_BIT };
+const uint32_t ATTR_SWEEP_CHANNELS[] = { 1, 2 };
+const uint32_t ATTR_SWEEP_SAMPLE_RATES[] = {
+    8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000, 64000, 96000
+};
+const uint32_t ATTR_SWEEP_PERIODS[] = { 1024, 2048, 4096 };
+
+struct AudioLatencyHistogram {
+    uint64_t buckets[LATENCY_BUCKET_COUNT];
+    uint64_t count;
+    int64_t min;
+    int64_t max;
+    double mean;
+    double m2;
+};
+
+struct AudioStressStream {
+    enum AudioPortDirection portType;
+    const char *adapterName;
+    enum AudioPortPin pins;
+    int32_t result;
+    uint64_t bytes;
+    uint64_t frames;
+    uint64_t xruns; /* times the stream fell more than one buffer behind real time */
+    struct AudioLatencyHistogram histogram;
+};
+
+struct AudioStressReport {
+    uint32_t streamCount;
+    int64_t elapsedNs;
+    uint64_t bytes;
+    uint64_t xruns;
+    double bytesPerSecond;
+    struct AudioStressStream streams[STRESS_MAX_STREAMS];
+    struct AudioLatencyHistogram histogram;
+};
+
+/* submit-to-WRITE_COMPLETED latency of a render driven through the RegCallback completion path */
+struct AudioNonblockStats {
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t renderFull;
+    uint64_t timeouts; /* waits for a completion that gave up after NONBLOCK_EVENT_TIMEOUT_NS */
+    uint64_t dropped;  /* events lost because the callback queue was full */
+    struct AudioLatencyHistogram histogram;
+};
+
+/* every combination of the four axes is applied in turn to one already created render or capture */
+struct AudioAttrSweep {
+    const enum AudioFormat *formats;
+    uint32_t formatCount;
+    const uint32_t *channels;
+    uint32_t channelCount;
+    const uint32_t *sampleRates;
+    uint32_t sampleRateCount;
+    const uint32_t *periods;
+    uint32_t periodCount;
+};
+
+struct AudioAttrSweepCase {
+    enum AudioFormat format;
+    uint32_t channelCount;
+    uint32_t sampleRate;
+    uint32_t period;
+    int32_t result;       /* first failing HDI return of the case, AUDIO_HAL_SUCCESS otherwise */
+    bool matched;         /* GetSampleAttributes read back the format, rate and channels that were set */
+    int64_t setGetNs;     /* SetSampleAttributes plus GetSampleAttributes round trip */
+    int64_t firstFrameNs; /* Start until the first RenderFrame/CaptureFrame returned data, -1 if never */
+};
+
+/* the legal attributes the renderAttr and captureAttr suites otherwise check one case at a time */
+const struct AudioAttrSweep ATTR_SWEEP_LEGAL = {
+    ATTR_SWEEP_FORMATS, sizeof(ATTR_SWEEP_FORMATS) / sizeof(ATTR_SWEEP_FORMATS[0]),
+    ATTR_SWEEP_CHANNELS, sizeof(ATTR_SWEEP_CHANNELS) / sizeof(ATTR_SWEEP_CHANNELS[0]),
+    ATTR_SWEEP_SAMPLE_RATES, sizeof(ATTR_SWEEP_SAMPLE_RATES) / sizeof(ATTR_SWEEP_SAMPLE_RATES[0]),
+    ATTR_SWEEP_PERIODS, sizeof(ATTR_SWEEP_PERIODS) / sizeof(ATTR_SWEEP_PERIODS[0])
+};
+
+/* least-squares fit of reported frames against the reported timestamp while a stream is running */
+struct AudioClockReport {
+    uint32_t samples;        /* queries whose frame count had advanced */
+    uint32_t regressions;    /* queries that reported fewer frames than the one before */
+    bool hostTimed;          /* the HAL left the timestamp unset, so CLOCK_MONOTONIC at the query was fitted */
+    uint32_t nominalRate;
+    double framesPerSecond;
+    double driftPpm;         /* fitted rate against the nominal sample rate */
+    double jitterUs;         /* standard deviation of the fit residuals, in time */
+    double maxResidualUs;
+    double meanStalenessUs;  /* CLOCK_MONOTONIC at the query minus the reported timestamp */
+    double maxStalenessUs;
+};
+
+/* one SelectScene issued on a running stream */
+struct AudioSceneSwitch {
+    enum AudioPortPin pins;
+    int32_t result;
+    int64_t callNs;
+    int64_t stallNs;  /* longest time the position stood still during the dwell that followed the call */
+    int64_t glitchNs; /* stallNs beyond the longest stall of the dwell before the first switch */
+};
+
+/* scene switches cycle through the given pins; the steady-state stall is the position granularity of the HAL */
+struct AudioSceneReport {
+    int64_t baselineStallNs;
+    uint32_t regressions; /* position queries that went backwards */
+    uint32_t glitches;    /* switches whose glitch exceeded SCENE_GLITCH_TOLERANCE_NS */
+    struct AudioLatencyHistogram callLatency;
+    struct AudioLatencyHistogram glitchLatency;
+    std::vector<struct AudioSceneSwitch> switches;
+};
+
+enum AudioRampTarget {
+    AUDIO_RAMP_VOLUME = 0,
+    AUDIO_RAMP_GAIN = 1,
+};
+
+/* a triangle between low and high, stepped rateHz times per second */
+struct AudioRampParams {
+    enum AudioRampTarget target;
+    float low;
+    float high;
+    uint32_t rateHz;
+    uint32_t periodMs;
+    uint32_t durationMs;
+};
+
+struct AudioRampReport {
+    int32_t result;         /* first failing set call, AUDIO_HAL_SUCCESS otherwise */
+    int32_t streamResult;   /* the playback or capture that ran under the ramp */
+    uint64_t updates;
+    uint64_t failures;
+    double updatesPerSecond;
+    uint64_t monitoredBytes;
+    struct AudioEnvelopeStats envelope; /* of the captured signal, all zero without a monitor */
+    struct AudioLatencyHistogram histogram;
+};
+
+struct AudioSoakSample {
+    int64_t elapsedNs;
+    uint64_t rssKb;
+    uint32_t fds;
+    uint32_t adapters;          /* adapters loaded through GetLoadAdapter */
+    uint32_t adapterReferences; /* render and capture handles still holding them */
+    uint64_t renderBytes;
+    uint64_t captureBytes;
+};
+
+/* the first sample is taken before any stream exists and the last one after all of them are torn down */
+struct AudioSoakReport {
+    int32_t renderResult;
+    int32_t captureResult;
+    uint32_t renderCycles;
+    uint32_t captureCycles;
+    double rssSlopeKbPerHour;
+    std::vector<struct AudioSoakSample> samples;
+};
+
+void LatencyHistogramInit(struct AudioLatencyHistogram &histogram);
+
+void LatencyHistogramRecord(struct AudioLatencyHistogram &histogram, int64_t valueNs);
+
+void LatencyHistogramMerge(struct AudioLatencyHistogram &dst, const struct AudioLatencyHistogram &src);
+
+int64_t LatencyHistogramPercentile(const struct AudioLatencyHistogram &histogram, double percentile);
+
+double LatencyHistogramJitter(const struct AudioLatencyHistogram &histogram);
+
+void LatencyHistogramPrint(const char *label, const struct AudioLatencyHistogram &histogram);
+
+int32_t RenderFrameLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioLatencyHistogram &histogram);
+
+int32_t CaptureFrameLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioLatencyHistogram &histogram);
+
+int32_t RenderNonblockLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioNonblockStats &stats);
+
+void NonblockStatsPrint(const char *label, const struct AudioNonblockStats &stats);
+
+int32_t RenderAttrSweep(struct PrepareAudioPara &audiopara, const struct AudioAttrSweep &sweep,
+    std::vector<struct AudioAttrSweepCase> &cases);
+
+int32_t CaptureAttrSweep(struct PrepareAudioPara &audiopara, const struct AudioAttrSweep &sweep,
+    std::vector<struct AudioAttrSweepCase> &cases);
+
+void AttrSweepPrintCsv(const char *label, const std::vector<struct AudioAttrSweepCase> &cases);
+
+int32_t RenderPositionAnalyze(struct AudioRender *render, uint32_t durationMs, struct AudioClockReport &report);
+
+int32_t CapturePositionAnalyze(struct AudioCapture *capture, uint32_t durationMs, struct AudioClockReport &report);
+
+void ClockReportPrint(const char *label, const struct AudioClockReport &report);
+
+int32_t RenderSceneSwitchRun(struct AudioRender *render, const enum AudioPortPin *pins, uint32_t pinCount,
+    uint32_t switchCount, struct AudioSceneReport &report);
+
+int32_t CaptureSceneSwitchRun(struct AudioCapture *capture, const enum AudioPortPin *pins, uint32_t pinCount,
+    uint32_t switchCount, struct AudioSceneReport &report);
+
+void SceneReportPrint(const char *label, const struct AudioSceneReport &report);
+
+void RampParamsDefault(struct AudioRampParams &params, enum AudioRampTarget target, float low, float high);
+
+int32_t RenderRampRun(struct AudioRender *render, struct AudioCapture *monitor, const struct AudioRampParams &params,
+    struct AudioRampReport &report);
+
+int32_t CaptureRampRun(struct AudioCapture *capture, const struct AudioRampParams &params,
+    struct AudioRampReport &report);
+
+void RampReportPrint(const char *label, const struct AudioRampReport &report);
+
+uint32_t SoakDurationMs();
+
+int32_t AudioSoakRun(TestAudioManager *manager, uint32_t durationMs, struct AudioSoakReport &report);
+
+void AudioSoakPrint(const struct AudioSoakReport &report);
+
+int32_t AudioStressRun(TestAudioManager *manager, uint32_t renderCount, uint32_t captureCount, uint32_t durationMs,
+    struct AudioStressReport &report);
+
+void AudioStressPrint(const struct AudioStressReport &report);
+
+void MmapStreamPrint(const char *label, const struct AudioMmapStreamStats &stats);
+}
+}
+#endif // AUDIO_HDI_PERF_H
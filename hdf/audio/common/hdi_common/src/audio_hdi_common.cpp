@@ -33,16 +33,44 @@
  * @version 1.0
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <ctime>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "audio_hdi_common.h"
 
 using namespace std;
 
-static int g_frameStatus = 1;
+static std::atomic<int> g_frameStatus(1);
+static std::mutex g_frameStatusMutex;
+static std::condition_variable g_frameStatusCond;
 static int g_writeCompleted = 0;
 static int g_renderFull = 0;
 static int g_flushCompleted = 0;
 namespace HMOS {
 namespace Audio {
+/* blocks the render/capture loop while FrameStatus(0) is in effect instead of spinning on the flag */
+static void WaitFrameStatus()
+{
+    if (g_frameStatus.load()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(g_frameStatusMutex);
+    g_frameStatusCond.wait(lock, [] { return g_frameStatus.load() != 0; });
+}
+
 int32_t InitAttrs(struct AudioSampleAttributes &attrs)
 {
     attrs.format = AUDIO_FORMAT_PCM_16_BIT;
@@ -106,6 +134,13 @@ int32_t AudioCaptureSetGetSampleAttributes(struct AudioSampleAttributes attrs, s
     return AUDIO_HAL_SUCCESS;
 }
 
+int64_t GetMonotonicNs()
+{
+    struct timespec now = {};
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * SECTONSEC + now.tv_nsec;
+}
+
 uint32_t StringToInt(std::string flag)
 {
     uint32_t temp = flag[0];
@@ -178,23 +213,15 @@ uint32_t PcmFramesToBytes(const struct AudioSampleAttributes attrs)
     return ret;
 }
 
-int32_t WavHeadAnalysis(struct AudioHeadInfo &wavHeadInfo, FILE *file, struct AudioSampleAttributes &attrs)
+int32_t WavHeadCheck(const struct AudioHeadInfo &wavHeadInfo, struct AudioSampleAttributes &attrs)
 {
-    size_t ret = 0;
-    if (file == nullptr) {
-        return HDF_FAILURE;
-    }
-    ret = fread(&wavHeadInfo, sizeof(wavHeadInfo), 1, file);
-    if (ret != 1) {
-        return HDF_FAILURE;
-    }
     uint32_t audioRiffId = StringToInt(AUDIO_RIFF);
     uint32_t audioFileFmt = StringToInt(AUDIO_WAVE);
     uint32_t audioDataId = StringToInt(AUDIO_DATA);
     if (wavHeadInfo.testFileRiffId != audioRiffId || wavHeadInfo.testFileFmt != audioFileFmt ||
         wavHeadInfo.dataId != audioDataId) {
         return HDF_FAILURE;
-        }
+    }
     attrs.channelCount = wavHeadInfo.audioChannelNum;
     attrs.sampleRate = wavHeadInfo.audioSampleRate;
     switch (wavHeadInfo.audioBitsPerSample) {
@@ -220,6 +247,64 @@ int32_t WavHeadAnalysis(struct AudioHeadInfo &wavHeadInfo, FILE *file, struct Au
     return HDF_SUCCESS;
 }
 
+int32_t WavHeadAnalysis(struct AudioHeadInfo &wavHeadInfo, FILE *file, struct AudioSampleAttributes &attrs)
+{
+    size_t ret = 0;
+    if (file == nullptr) {
+        return HDF_FAILURE;
+    }
+    ret = fread(&wavHeadInfo, sizeof(wavHeadInfo), 1, file);
+    if (ret != 1) {
+        return HDF_FAILURE;
+    }
+    return WavHeadCheck(wavHeadInfo, attrs);
+}
+
+int32_t WavMapOpen(const char *path, struct AudioWavMapping &mapping, struct AudioHeadInfo &wavHeadInfo,
+    struct AudioSampleAttributes &attrs)
+{
+    struct stat fileStat = {};
+    char absPath[PATH_MAX] = {0};
+    mapping = {};
+    if (path == nullptr || realpath(path, absPath) == nullptr) {
+        return HDF_FAILURE;
+    }
+    int fd = open(absPath, O_RDONLY);
+    if (fd < 0) {
+        return HDF_FAILURE;
+    }
+    if (fstat(fd, &fileStat) < 0 || fileStat.st_size <= static_cast<off_t>(sizeof(wavHeadInfo))) {
+        (void)close(fd);
+        return HDF_FAILURE;
+    }
+    size_t length = static_cast<size_t>(fileStat.st_size);
+    void *base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (base == MAP_FAILED) {
+        return HDF_FAILURE;
+    }
+    (void)madvise(base, length, MADV_SEQUENTIAL);
+    wavHeadInfo = *static_cast<const struct AudioHeadInfo *>(base);
+    if (WavHeadCheck(wavHeadInfo, attrs) < 0) {
+        munmap(base, length);
+        return HDF_FAILURE;
+    }
+    mapping.base = static_cast<uint8_t *>(base);
+    mapping.length = length;
+    mapping.data = mapping.base + sizeof(wavHeadInfo);
+    uint64_t available = length - sizeof(wavHeadInfo);
+    mapping.dataSize = wavHeadInfo.dataSize > available ? available : wavHeadInfo.dataSize;
+    return HDF_SUCCESS;
+}
+
+void WavMapClose(struct AudioWavMapping &mapping)
+{
+    if (mapping.base != nullptr) {
+        munmap(mapping.base, mapping.length);
+    }
+    mapping = {};
+}
+
 int32_t GetAdapters(TestAudioManager *manager, struct AudioAdapterDescriptor **descs, int &size)
 {
     int32_t ret = -1;
@@ -236,42 +321,274 @@ int32_t GetAdapters(TestAudioManager *manager, struct AudioAdapterDescriptor **d
     return AUDIO_HAL_SUCCESS;
 }
 
-int32_t GetLoadAdapter(TestAudioManager *manager, enum AudioPortDirection portType,
-    const std::string &adapterName, struct AudioAdapter **adapter, struct AudioPort *&audioPort)
+namespace {
+struct LoadedAdapter {
+    struct AudioAdapter *adapter;
+    uint32_t refCount;
+};
+
+struct CachedPort {
+    int descIndex;
+    struct AudioPort *port;
+};
+
+/* per-manager adapter index and load refcounts; the driver's function table is never touched */
+struct AdapterCacheState {
+    struct AudioAdapterDescriptor *descs = nullptr;
+    bool indexed = false;
+    bool retain = false;
+    std::unordered_map<std::string, struct CachedPort> ports;
+    std::unordered_map<std::string, struct LoadedAdapter> loaded;
+};
+
+std::mutex g_adapterCacheMutex;
+std::map<TestAudioManager *, struct AdapterCacheState> g_adapterCache;
+
+std::string AdapterPortKey(const std::string &adapterName, enum AudioPortDirection portType)
+{
+    return adapterName + '\0' + std::to_string(static_cast<int>(portType));
+}
+
+int32_t IndexAdapters(TestAudioManager *manager, struct AdapterCacheState &state)
 {
-    int32_t ret = -1;
     int size = 0;
-    struct AudioAdapterDescriptor *desc = nullptr;
-    struct AudioAdapterDescriptor *descs = nullptr;
-    if (adapter == nullptr) {
-        return AUDIO_HAL_ERR_INVALID_PARAM;
+    if (state.indexed) {
+        return AUDIO_HAL_SUCCESS;
     }
-    ret = GetAdapters(manager, &descs, size);
+    int32_t ret = GetAdapters(manager, &state.descs, size);
     if (ret < 0) {
         return ret;
     }
-    if (descs == nullptr) {
+    if (size > ADAPTER_COUNT) {
         return AUDIO_HAL_ERR_INTERNAL;
     }
+    for (int index = 0; index < size; index++) {
+        struct AudioAdapterDescriptor *desc = &state.descs[index];
+        if (desc->adapterName == nullptr) {
+            continue;
+        }
+        for (uint32_t port = 0; port < desc->portNum; port++) {
+            /* keep the first port per direction, as SwitchAdapter does */
+            struct CachedPort cached = { index, &desc->ports[port] };
+            (void)state.ports.emplace(AdapterPortKey(desc->adapterName, desc->ports[port].dir), cached);
+        }
+    }
+    state.indexed = true;
+    return AUDIO_HAL_SUCCESS;
+}
+}
 
-    int index = SwitchAdapter(descs, adapterName, portType, audioPort, size);
-    if (index < 0) {
+int32_t GetLoadAdapter(TestAudioManager *manager, enum AudioPortDirection portType,
+    const std::string &adapterName, struct AudioAdapter **adapter, struct AudioPort *&audioPort)
+{
+    int32_t ret = -1;
+    if (manager == nullptr || adapter == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(g_adapterCacheMutex);
+    struct AdapterCacheState &state = g_adapterCache[manager];
+    ret = IndexAdapters(manager, state);
+    if (ret < 0) {
+        return ret;
+    }
+    auto cached = state.ports.find(AdapterPortKey(adapterName, portType));
+    if (cached == state.ports.end()) {
         return AUDIO_HAL_ERR_INTERNAL;
     }
-    desc = &descs[index];
-    if (desc == nullptr) {
-        return AUDIO_HAL_ERR_INVALID_PARAM;
+    audioPort = cached->second.port;
+    auto loaded = state.loaded.find(adapterName);
+    if (loaded != state.loaded.end()) {
+        loaded->second.refCount++;
+        *adapter = loaded->second.adapter;
+        return AUDIO_HAL_SUCCESS;
     }
-    ret = manager->LoadAdapter(manager, desc, adapter);
+    ret = manager->LoadAdapter(manager, &state.descs[cached->second.descIndex], adapter);
     if (ret < 0) {
         return ret;
     }
     if (*adapter == nullptr) {
         return AUDIO_HAL_ERR_INTERNAL;
     }
+    struct LoadedAdapter entry = { *adapter, 1 };
+    state.loaded[adapterName] = entry;
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* drops one GetLoadAdapter reference; an adapter the cache does not know is unloaded straight away */
+void ReleaseLoadAdapter(TestAudioManager *manager, struct AudioAdapter *adapter)
+{
+    if (manager == nullptr || manager->UnloadAdapter == nullptr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(g_adapterCacheMutex);
+    auto state = g_adapterCache.find(manager);
+    if (state != g_adapterCache.end()) {
+        for (auto loaded = state->second.loaded.begin(); loaded != state->second.loaded.end(); ++loaded) {
+            if (loaded->second.adapter != adapter) {
+                continue;
+            }
+            loaded->second.refCount -= loaded->second.refCount > 0 ? 1 : 0;
+            if (loaded->second.refCount > 0 || state->second.retain) {
+                return;
+            }
+            state->second.loaded.erase(loaded);
+            break;
+        }
+        /* the driver may rebuild its descriptors once an adapter is gone */
+        state->second.indexed = false;
+        state->second.ports.clear();
+    }
+    lock.unlock();
+    manager->UnloadAdapter(manager, adapter);
+}
+
+int32_t AdapterCacheRetain(TestAudioManager *manager, bool retain)
+{
+    if (manager == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(g_adapterCacheMutex);
+    g_adapterCache[manager].retain = retain;
     return AUDIO_HAL_SUCCESS;
 }
 
+void AdapterCacheRelease(TestAudioManager *manager)
+{
+    if (manager == nullptr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(g_adapterCacheMutex);
+    auto state = g_adapterCache.find(manager);
+    if (state == g_adapterCache.end()) {
+        return;
+    }
+    std::vector<struct AudioAdapter *> adapters;
+    for (auto &loaded : state->second.loaded) {
+        adapters.push_back(loaded.second.adapter);
+    }
+    g_adapterCache.erase(state);
+    lock.unlock();
+    for (struct AudioAdapter *adapter : adapters) {
+        manager->UnloadAdapter(manager, adapter);
+    }
+}
+
+/* adapters currently loaded through GetLoadAdapter and the handles still held on them */
+void AdapterCacheCounts(TestAudioManager *manager, uint32_t &adapters, uint32_t &references)
+{
+    adapters = 0;
+    references = 0;
+    std::lock_guard<std::mutex> lock(g_adapterCacheMutex);
+    auto state = g_adapterCache.find(manager);
+    if (state == g_adapterCache.end()) {
+        return;
+    }
+    for (auto &loaded : state->second.loaded) {
+        adapters++;
+        references += loaded.second.refCount;
+    }
+}
+
+namespace {
+/* RESOLVED_PATH is opened once per process, so suites linked into one binary share the driver */
+struct AudioLoader {
+    std::once_flag resolved;
+    void *handle;
+    GetAudioManagerFunc getAudioManager;
+    bool overridden;
+#ifdef AUDIO_MPI_SO
+    std::once_flag sdkStarted;
+    void *sdkHandle;
+    void (*sdkExit)();
+#endif
+};
+
+struct AudioLoader g_audioLoader;
+
+void AudioLoaderExit()
+{
+#ifdef AUDIO_MPI_SO
+    if (g_audioLoader.sdkExit != nullptr) {
+        g_audioLoader.sdkExit();
+    }
+    if (g_audioLoader.sdkHandle != nullptr) {
+        dlclose(g_audioLoader.sdkHandle);
+    }
+#endif
+    if (g_audioLoader.handle != nullptr) {
+        dlclose(g_audioLoader.handle);
+    }
+}
+
+/* AUDIO_HAL_LIBRARY swaps the vendor HAL for a stand-in such as libhdi_audio_loopback on a host build */
+void AudioLoaderResolve()
+{
+    char absPath[PATH_MAX] = {0};
+    const char *override = getenv(HAL_LIBRARY_ENV);
+    g_audioLoader.overridden = override != nullptr;
+    if (realpath(override != nullptr ? override : RESOLVED_PATH.c_str(), absPath) == nullptr) {
+        return;
+    }
+    void *handle = dlopen(absPath, RTLD_LAZY);
+    if (handle == nullptr) {
+        return;
+    }
+    GetAudioManagerFunc getAudioManager = (GetAudioManagerFunc)(dlsym(handle, FUNCTION_NAME.c_str()));
+    if (getAudioManager == nullptr) {
+        dlclose(handle);
+        return;
+    }
+    g_audioLoader.handle = handle;
+    g_audioLoader.getAudioManager = getAudioManager;
+    (void)atexit(AudioLoaderExit);
+}
+
+#ifdef AUDIO_MPI_SO
+void AudioLoaderStartSdk()
+{
+    void *sdkHandle = dlopen(SDK_RESOLVED_PATH.c_str(), RTLD_LAZY);
+    if (sdkHandle == nullptr) {
+        return;
+    }
+    int32_t (*sdkInit)() = (int32_t (*)())(dlsym(sdkHandle, "MpiSdkInit"));
+    void (*sdkExit)() = (void (*)())(dlsym(sdkHandle, "MpiSdkExit"));
+    if (sdkInit == nullptr || sdkExit == nullptr) {
+        dlclose(sdkHandle);
+        return;
+    }
+    sdkInit();
+    g_audioLoader.sdkHandle = sdkHandle;
+    g_audioLoader.sdkExit = sdkExit;
+}
+#endif
+
+/* handed to the suites as their GetAudioManager; the MPI SDK comes up on the first call that needs the driver */
+TestAudioManager *LoaderGetAudioManager()
+{
+#ifdef AUDIO_MPI_SO
+    if (!g_audioLoader.overridden) {
+        std::call_once(g_audioLoader.sdkStarted, AudioLoaderStartSdk);
+    }
+#endif
+    return g_audioLoader.getAudioManager();
+}
+}
+
+GetAudioManagerFunc AudioLoaderGetManagerFunc()
+{
+    std::call_once(g_audioLoader.resolved, AudioLoaderResolve);
+    if (g_audioLoader.getAudioManager == nullptr) {
+        return nullptr;
+    }
+    return LoaderGetAudioManager;
+}
+
+bool AudioLoaderOverridden()
+{
+    std::call_once(g_audioLoader.resolved, AudioLoaderResolve);
+    return g_audioLoader.getAudioManager != nullptr && g_audioLoader.overridden;
+}
+
 int32_t AudioCreateRender(TestAudioManager *manager, enum AudioPortPin pins, const std::string &adapterName,
     struct AudioAdapter **adapter, struct AudioRender **render)
 {
@@ -293,11 +610,11 @@ int32_t AudioCreateRender(TestAudioManager *manager, enum AudioPortPin pins, con
     InitDevDesc(devDesc, renderPort->portId, pins);
     ret = (*adapter)->CreateRender(*adapter, &devDesc, &attrs, render);
     if (ret < 0) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return ret;
     }
     if (*render == nullptr) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return AUDIO_HAL_ERR_INTERNAL;
     }
     return AUDIO_HAL_SUCCESS;
@@ -322,7 +639,7 @@ int32_t AudioCreateStartRender(TestAudioManager *manager, struct AudioRender **r
     ret = AudioRenderStartAndOneFrame(*render);
     if (ret < 0) {
         (*adapter)->DestroyRender(*adapter, *render);
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return ret;
     }
     return AUDIO_HAL_SUCCESS;
@@ -331,9 +648,9 @@ int32_t AudioCreateStartRender(TestAudioManager *manager, struct AudioRender **r
 int32_t AudioRenderStartAndOneFrame(struct AudioRender *render)
 {
     int32_t ret = -1;
-    char *frame = nullptr;
-    uint64_t numRead = 0;
     uint64_t replyBytes = 0;
+    struct AudioSampleAttributes attrs = {};
+    const struct AudioPcmFixture *fixture = nullptr;
     if (render == nullptr || render->control.Start == nullptr || render->RenderFrame == nullptr) {
         return AUDIO_HAL_ERR_INVALID_PARAM;
     }
@@ -341,24 +658,15 @@ int32_t AudioRenderStartAndOneFrame(struct AudioRender *render)
     if (ret) {
         return ret;
     }
-    ret = RenderFramePrepare(AUDIO_FILE, frame, numRead);
+    InitAttrs(attrs);
+    ret = GetPcmFixture(AUDIO_FILE, attrs, fixture);
     if (ret < 0) {
-        if (frame != nullptr) {
-            free(frame);
-            frame = nullptr;
-        }
         return HDF_FAILURE;
     }
-    ret = render->RenderFrame(render, frame, numRead, &replyBytes);
+    ret = render->RenderFrame(render, fixture->frame, fixture->frameSize, &replyBytes);
     if (ret < 0) {
-        if (frame != nullptr) {
-            free(frame);
-            frame = nullptr;
-        }
         return ret;
     }
-    free(frame);
-    frame = nullptr;
     return AUDIO_HAL_SUCCESS;
 }
 
@@ -383,11 +691,11 @@ int32_t AudioCreateCapture(TestAudioManager *manager, enum AudioPortPin pins, co
     InitDevDesc(devDesc, capturePort->portId, pins);
     ret = (*adapter)->CreateCapture(*adapter, &devDesc, &attrs, capture);
     if (ret < 0) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return ret;
     }
     if (*capture == nullptr) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return AUDIO_HAL_ERR_INTERNAL;
     }
     return AUDIO_HAL_SUCCESS;
@@ -404,24 +712,24 @@ int32_t AudioCreateStartCapture(TestAudioManager *manager, struct AudioCapture *
     }
     ret = AudioCreateCapture(manager, pins, adapterName, adapter, capture);
     if (ret < 0) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return ret;
     }
     if (*capture == nullptr || *adapter == nullptr) {
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return AUDIO_HAL_ERR_INTERNAL;
     }
     FILE *file = fopen(AUDIO_CAPTURE_FILE.c_str(), "wb+");
     if (file == nullptr) {
         (*adapter)->DestroyCapture(*adapter, *capture);
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         return HDF_FAILURE;
     }
     InitAttrs(attrs);
     ret = FrameStartCapture((*capture), file, attrs);
     if (ret < 0) {
         (*adapter)->DestroyCapture(*adapter, *capture);
-        manager->UnloadAdapter(manager, *adapter);
+        ReleaseLoadAdapter(manager, *adapter);
         (void)fclose(file);
         return ret;
     }
@@ -447,6 +755,191 @@ int32_t AudioCaptureStartAndOneFrame(struct AudioCapture *capture)
     return AUDIO_HAL_SUCCESS;
 }
 
+static void PooledRenderBaseline(struct AudioPooledStream &slot)
+{
+    struct AudioRender *render = slot.render;
+    slot.hasBaseline = render->volume.GetMute(render, &slot.mute) == AUDIO_HAL_SUCCESS &&
+        render->volume.GetVolume(render, &slot.volume) == AUDIO_HAL_SUCCESS &&
+        render->volume.GetGain(render, &slot.gain) == AUDIO_HAL_SUCCESS;
+}
+
+static void PooledCaptureBaseline(struct AudioPooledStream &slot)
+{
+    struct AudioCapture *capture = slot.capture;
+    slot.hasBaseline = capture->volume.GetMute(capture, &slot.mute) == AUDIO_HAL_SUCCESS &&
+        capture->volume.GetVolume(capture, &slot.volume) == AUDIO_HAL_SUCCESS &&
+        capture->volume.GetGain(capture, &slot.gain) == AUDIO_HAL_SUCCESS;
+}
+
+/* stops the stream and puts back the default attributes and the creation-time volume state */
+static int32_t PooledRenderReset(struct AudioPooledStream &slot)
+{
+    struct AudioRender *render = slot.render;
+    struct AudioSampleAttributes attrs = {};
+    (void)render->control.Stop((AudioHandle)render);
+    InitAttrs(attrs);
+    int32_t ret = render->attr.SetSampleAttributes(render, &attrs);
+    if (ret < 0 || !slot.hasBaseline) {
+        return ret;
+    }
+    ret = render->volume.SetMute(render, slot.mute);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = render->volume.SetVolume(render, slot.volume);
+    if (ret < 0) {
+        return ret;
+    }
+    return render->volume.SetGain(render, slot.gain);
+}
+
+static int32_t PooledCaptureReset(struct AudioPooledStream &slot)
+{
+    struct AudioCapture *capture = slot.capture;
+    struct AudioSampleAttributes attrs = {};
+    (void)capture->control.Stop((AudioHandle)capture);
+    InitAttrs(attrs);
+    int32_t ret = capture->attr.SetSampleAttributes(capture, &attrs);
+    if (ret < 0 || !slot.hasBaseline) {
+        return ret;
+    }
+    ret = capture->volume.SetMute(capture, slot.mute);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = capture->volume.SetVolume(capture, slot.volume);
+    if (ret < 0) {
+        return ret;
+    }
+    return capture->volume.SetGain(capture, slot.gain);
+}
+
+static void PooledStreamDestroy(TestAudioManager *manager, struct AudioPooledStream &slot)
+{
+    if (slot.render != nullptr) {
+        (void)slot.render->control.Stop((AudioHandle)slot.render);
+        slot.adapter->DestroyRender(slot.adapter, slot.render);
+    }
+    if (slot.capture != nullptr) {
+        (void)slot.capture->control.Stop((AudioHandle)slot.capture);
+        slot.adapter->DestroyCapture(slot.adapter, slot.capture);
+    }
+    if (slot.adapter != nullptr) {
+        ReleaseLoadAdapter(manager, slot.adapter);
+    }
+    slot = {};
+}
+
+void StreamPoolInit(struct AudioStreamPool &pool, TestAudioManager *manager)
+{
+    pool = {};
+    pool.manager = manager;
+}
+
+int32_t StreamPoolAcquireRender(struct AudioStreamPool &pool, struct AudioAdapter **adapter,
+    struct AudioRender **render)
+{
+    struct AudioPooledStream &slot = pool.render;
+    if (pool.manager == nullptr || adapter == nullptr || render == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    /* a second render in the same test is created fresh and destroyed on release */
+    if (slot.inUse) {
+        return AudioCreateRender(pool.manager, PIN_OUT_SPEAKER, ADAPTER_NAME, adapter, render);
+    }
+    if (slot.render != nullptr && PooledRenderReset(slot) < 0) {
+        PooledStreamDestroy(pool.manager, slot);
+    }
+    if (slot.render == nullptr) {
+        int32_t ret = AudioCreateRender(pool.manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &slot.adapter, &slot.render);
+        if (ret < 0) {
+            slot = {};
+            return ret;
+        }
+        PooledRenderBaseline(slot);
+        pool.created++;
+    } else {
+        pool.reused++;
+    }
+    slot.inUse = true;
+    *adapter = slot.adapter;
+    *render = slot.render;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t StreamPoolAcquireCapture(struct AudioStreamPool &pool, struct AudioAdapter **adapter,
+    struct AudioCapture **capture)
+{
+    struct AudioPooledStream &slot = pool.capture;
+    if (pool.manager == nullptr || adapter == nullptr || capture == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    if (slot.inUse) {
+        return AudioCreateCapture(pool.manager, PIN_IN_MIC, ADAPTER_NAME, adapter, capture);
+    }
+    if (slot.capture != nullptr && PooledCaptureReset(slot) < 0) {
+        PooledStreamDestroy(pool.manager, slot);
+    }
+    if (slot.capture == nullptr) {
+        int32_t ret = AudioCreateCapture(pool.manager, PIN_IN_MIC, ADAPTER_NAME, &slot.adapter, &slot.capture);
+        if (ret < 0) {
+            slot = {};
+            return ret;
+        }
+        PooledCaptureBaseline(slot);
+        pool.created++;
+    } else {
+        pool.reused++;
+    }
+    slot.inUse = true;
+    *adapter = slot.adapter;
+    *capture = slot.capture;
+    return AUDIO_HAL_SUCCESS;
+}
+
+void StreamPoolReleaseRender(struct AudioStreamPool &pool, struct AudioAdapter *adapter, struct AudioRender *render)
+{
+    if (render == nullptr || adapter == nullptr) {
+        return;
+    }
+    if (render == pool.render.render) {
+        pool.render.inUse = false;
+        return;
+    }
+    adapter->DestroyRender(adapter, render);
+    ReleaseLoadAdapter(pool.manager, adapter);
+}
+
+void StreamPoolReleaseCapture(struct AudioStreamPool &pool, struct AudioAdapter *adapter,
+    struct AudioCapture *capture)
+{
+    if (capture == nullptr || adapter == nullptr) {
+        return;
+    }
+    if (capture == pool.capture.capture) {
+        pool.capture.inUse = false;
+        return;
+    }
+    adapter->DestroyCapture(adapter, capture);
+    ReleaseLoadAdapter(pool.manager, adapter);
+}
+
+/* called from the fixture TearDown so a test that stopped at an ASSERT does not keep its stream checked out */
+void StreamPoolReclaim(struct AudioStreamPool &pool)
+{
+    pool.render.inUse = false;
+    pool.capture.inUse = false;
+}
+
+void StreamPoolDeinit(struct AudioStreamPool &pool)
+{
+    if (pool.manager != nullptr) {
+        PooledStreamDestroy(pool.manager, pool.render);
+        PooledStreamDestroy(pool.manager, pool.capture);
+    }
+    pool = {};
+}
+
 int32_t FrameStart(struct AudioHeadInfo wavHeadInfo, struct AudioRender *render, FILE *file,
     struct AudioSampleAttributes attrs)
 {
@@ -472,55 +965,138 @@ int32_t FrameStart(struct AudioHeadInfo wavHeadInfo, struct AudioRender *render,
         return HDF_ERR_MALLOC_FAIL;
     }
     do {
-        if (g_frameStatus) {
-            readSize = (remainingDataSize) > (bufferSize) ? (bufferSize) : (remainingDataSize);
-            numRead = fread(frame, readSize, 1, file);
-            if (numRead > 0) {
-                ret = render->RenderFrame(render, frame, readSize, &replyBytes);
-                if (ret < 0) {
-                    if (ret == -1) {
-                        if (tryNumFrame > TRY_NUM_FRAME) {
-                            free(frame);
-                            return ret;
-                        }
-                        tryNumFrame++;
-                        continue;
+        WaitFrameStatus();
+        readSize = (remainingDataSize) > (bufferSize) ? (bufferSize) : (remainingDataSize);
+        numRead = fread(frame, readSize, 1, file);
+        if (numRead > 0) {
+            ret = render->RenderFrame(render, frame, readSize, &replyBytes);
+            if (ret < 0) {
+                if (ret == -1) {
+                    if (tryNumFrame > TRY_NUM_FRAME) {
+                        free(frame);
+                        return ret;
                     }
-                    free(frame);
-                    return ret;
+                    tryNumFrame++;
+                    continue;
                 }
-                tryNumFrame = 0;
+                free(frame);
+                return ret;
             }
-            remainingDataSize -= readSize;
+            tryNumFrame = 0;
         }
+        remainingDataSize -= readSize;
     } while (readSize > 0 && remainingDataSize > 0);
     free(frame);
     return AUDIO_HAL_SUCCESS;
 }
 
-int32_t FrameStartCapture(struct AudioCapture *capture, FILE *file, const struct AudioSampleAttributes attrs)
+int32_t FrameStartMmap(struct AudioRender *render, const struct AudioWavMapping &mapping,
+    struct AudioSampleAttributes attrs)
 {
-    int32_t ret = 0;
-    uint32_t bufferSize = 0;
     uint64_t replyBytes = 0;
-    uint64_t requestBytes = 0;
-    if (capture == nullptr || capture->control.Start == nullptr || capture->CaptureFrame == nullptr) {
+    int32_t tryNumFrame = 0;
+    if (render == nullptr || render->control.Start == nullptr || render->RenderFrame == nullptr ||
+        mapping.data == nullptr) {
         return AUDIO_HAL_ERR_INVALID_PARAM;
     }
-    ret = capture->control.Start((AudioHandle)capture);
-    if (ret < 0) {
+    int32_t ret = render->control.Start((AudioHandle)render);
+    if (ret) {
         return ret;
     }
-    uint32_t pcmBytes = PcmFramesToBytes(attrs);
-    if (pcmBytes < 1024 || pcmBytes > 8192) {
-        return HDF_FAILURE;
-    }
-    bufferSize = FRAME_COUNT * pcmBytes;
+    uint32_t bufferSize = PcmFramesToBytes(attrs);
     if (bufferSize <= 0) {
         return HDF_FAILURE;
     }
-    char *frame = nullptr;
-    frame = (char *)calloc(1, bufferSize);
+    uint64_t offset = 0;
+    while (offset < mapping.dataSize) {
+        WaitFrameStatus();
+        uint64_t remainingDataSize = mapping.dataSize - offset;
+        uint64_t readSize = remainingDataSize > bufferSize ? bufferSize : remainingDataSize;
+        ret = render->RenderFrame(render, mapping.data + offset, readSize, &replyBytes);
+        if (ret < 0) {
+            if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+                continue;
+            }
+            return ret;
+        }
+        tryNumFrame = 0;
+        offset += readSize;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t FrameStartSynth(struct AudioRender *render, struct AudioPcmSynth &synth, struct AudioSampleAttributes attrs,
+    uint64_t frames)
+{
+    uint64_t replyBytes = 0;
+    int32_t tryNumFrame = 0;
+    if (render == nullptr || render->control.Start == nullptr || render->RenderFrame == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    int32_t ret = render->control.Start((AudioHandle)render);
+    if (ret) {
+        return ret;
+    }
+    uint32_t bufferSize = PcmFramesToBytes(attrs);
+    if (bufferSize <= 0) {
+        return HDF_FAILURE;
+    }
+    std::vector<char> frame(bufferSize);
+    uint64_t remainingDataSize = frames * (PcmFormatToBits(attrs.format) / MOVE_LEFT_NUM) * attrs.channelCount;
+    size_t readSize = 0;
+    while (remainingDataSize > 0) {
+        WaitFrameStatus();
+        /* a retried period is resent as is so the signal stays continuous */
+        if (tryNumFrame == 0) {
+            size_t length = remainingDataSize > bufferSize ? bufferSize : remainingDataSize;
+            readSize = PcmSynthFill(synth, frame.data(), length);
+            if (readSize == 0) {
+                break;
+            }
+        }
+        ret = render->RenderFrame(render, frame.data(), readSize, &replyBytes);
+        if (ret < 0) {
+            if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+                continue;
+            }
+            return ret;
+        }
+        tryNumFrame = 0;
+        remainingDataSize -= readSize;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t FrameStartCapture(struct AudioCapture *capture, FILE *file, const struct AudioSampleAttributes attrs)
+{
+    struct AudioPcmStats pcmStats = {};
+    return FrameStartCaptureVerify(capture, file, attrs, pcmStats);
+}
+
+int32_t FrameStartCaptureVerify(struct AudioCapture *capture, FILE *file, const struct AudioSampleAttributes attrs,
+    struct AudioPcmStats &pcmStats)
+{
+    int32_t ret = 0;
+    uint32_t bufferSize = 0;
+    uint64_t replyBytes = 0;
+    uint64_t requestBytes = 0;
+    if (capture == nullptr || capture->control.Start == nullptr || capture->CaptureFrame == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    ret = capture->control.Start((AudioHandle)capture);
+    if (ret < 0) {
+        return ret;
+    }
+    uint32_t pcmBytes = PcmFramesToBytes(attrs);
+    if (pcmBytes < 1024 || pcmBytes > 8192) {
+        return HDF_FAILURE;
+    }
+    bufferSize = FRAME_COUNT * pcmBytes;
+    if (bufferSize <= 0) {
+        return HDF_FAILURE;
+    }
+    char *frame = nullptr;
+    frame = (char *)calloc(1, bufferSize);
     if (frame == nullptr) {
         return HDF_ERR_MALLOC_FAIL;
     }
@@ -534,108 +1110,437 @@ int32_t FrameStartCapture(struct AudioCapture *capture, FILE *file, const struct
         }
     }
     uint32_t requestByte = static_cast<uint32_t>(replyBytes);
+    struct AudioPcmVerifier verifier = {};
+    if (PcmVerifyInit(verifier, attrs, 0) == AUDIO_HAL_SUCCESS) {
+        PcmVerifyFeed(verifier, frame, requestByte);
+    }
+    PcmVerifyResult(verifier, pcmStats);
     (void)fwrite(frame, requestByte, 1, file);
     free(frame);
     return AUDIO_HAL_SUCCESS;
 }
 
-int32_t RenderFramePrepare(const std::string &path, char *&frame, uint64_t &readSize)
+/* a period is heard once any sample in it is non-zero; only meaningful for the signed formats */
+static bool PeriodHeard(const std::vector<char> &frame, uint64_t length)
+{
+    return std::any_of(frame.begin(), frame.begin() + length, [](char value) { return value != 0; });
+}
+
+int32_t CaptureToneVerify(struct AudioRender *render, struct AudioCapture *capture, uint64_t frames,
+    struct AudioPcmStats &stats)
 {
-    int32_t ret = -1;
-    size_t numRead = 0;
-    uint32_t bufferSize = 4096;
-    uint32_t remainingDataSize = 0;
     struct AudioSampleAttributes attrs = {};
-    struct AudioHeadInfo headInfo = {};
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    struct AudioPcmVerifier verifier = {};
+    stats = {};
+    if (render == nullptr || capture == nullptr || capture->control.Start == nullptr ||
+        capture->control.Stop == nullptr || capture->CaptureFrame == nullptr || frames == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
     InitAttrs(attrs);
+    if (capture->attr.GetSampleAttributes != nullptr) {
+        (void)capture->attr.GetSampleAttributes(capture, &attrs);
+    }
+    PcmSynthDefault(params, AUDIO_SYNTH_SWEEP);
+    params.startHz = SYNTH_TONE_HZ;
+    params.endHz = SYNTH_TONE_HZ;
+    int32_t ret = PcmSynthInit(synth, attrs, params);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = PcmVerifyInit(verifier, attrs, SYNTH_TONE_HZ);
+    if (ret < 0) {
+        return ret;
+    }
+    std::vector<char> frame(PcmFramesToBytes(attrs));
+    uint64_t sampleBytes = PcmFormatToBits(attrs.format) / MOVE_LEFT_NUM;
+    uint64_t verifySamples = frames * attrs.channelCount;
+    /* the tone starts early and ends late by a lead in, so the verified span is all tone */
+    uint64_t leadFrames = attrs.sampleRate / 10; // 10: 100ms of lead in
+    uint64_t toneFrames = frames + leadFrames * 2; // 2: lead in on both ends
+    uint64_t captureBudget = toneFrames * attrs.channelCount * sampleBytes;
+    ret = capture->control.Start((AudioHandle)capture);
+    if (ret < 0) {
+        return ret;
+    }
+    int32_t renderRet = AUDIO_HAL_SUCCESS;
+    std::thread player([&]() { renderRet = FrameStartSynth(render, synth, attrs, toneFrames); });
+    uint64_t replyBytes = 0;
+    uint64_t capturedBytes = 0;
+    int32_t tryNumFrame = 0;
+    bool heard = false;
+    while (verifier.samples < verifySamples && capturedBytes < captureBudget) {
+        ret = capture->CaptureFrame(capture, frame.data(), frame.size(), &replyBytes);
+        if (ret < 0) {
+            if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+                continue;
+            }
+            break;
+        }
+        tryNumFrame = 0;
+        capturedBytes += replyBytes;
+        /* the first period with the tone in it is partly silent, verification starts with the next one */
+        if (heard) {
+            PcmVerifyFeed(verifier, frame.data(), replyBytes);
+        }
+        heard = heard || PeriodHeard(frame, replyBytes);
+    }
+    player.join();
+    (void)capture->control.Stop((AudioHandle)capture);
+    if (render->control.Stop != nullptr) {
+        (void)render->control.Stop((AudioHandle)render);
+    }
+    PcmVerifyResult(verifier, stats);
+    if (ret < 0) {
+        return ret;
+    }
+    return renderRet;
+}
+
+namespace {
+struct PcmFixtureEntry {
+    struct AudioPcmFixture fixture;
+    std::vector<char> storage;
+};
+
+std::mutex g_fixtureMutex;
+std::map<std::string, std::unique_ptr<PcmFixtureEntry>> g_fixtureCache;
+
+std::string PcmFixtureKey(const std::string &path, const struct AudioSampleAttributes &attrs)
+{
+    return path + "|" + std::to_string(attrs.format) + "|" + std::to_string(attrs.channelCount) + "|" +
+        std::to_string(attrs.sampleRate) + "|" + std::to_string(attrs.period);
+}
+
+int32_t LoadPcmFixture(const std::string &path, const struct AudioSampleAttributes &attrs, PcmFixtureEntry &entry)
+{
     char absPath[PATH_MAX] = {0};
-    if (realpath(path.c_str(), absPath) == nullptr) {
+    if (attrs.period == 0 || realpath(path.c_str(), absPath) == nullptr) {
         return HDF_FAILURE;
     }
     FILE *file = fopen(absPath, "rb");
     if (file == nullptr) {
         return HDF_FAILURE;
     }
-    ret = WavHeadAnalysis(headInfo, file, attrs);
-    if (ret < 0) {
+    entry.fixture.attrs = attrs;
+    if (WavHeadAnalysis(entry.fixture.headInfo, file, entry.fixture.attrs) < 0) {
         (void)fclose(file);
         return HDF_FAILURE;
     }
-    frame = (char *)calloc(1, bufferSize);
-    if (frame == nullptr) {
-        (void)fclose(file);
-        return HDF_ERR_MALLOC_FAIL;
-    }
-    remainingDataSize = headInfo.dataSize;
-    readSize = (remainingDataSize) > (bufferSize) ? (bufferSize) : (remainingDataSize);
-    size_t readSizes = static_cast<size_t>(readSize);
-    numRead = fread(frame, readSizes, 1, file);
-    if (numRead < 1) {
-        free(frame);
-        frame = nullptr;
+    uint64_t remainingDataSize = entry.fixture.headInfo.dataSize;
+    uint64_t readSize = remainingDataSize > attrs.period ? attrs.period : remainingDataSize;
+    entry.storage.resize(readSize);
+    if (readSize == 0 || fread(entry.storage.data(), readSize, 1, file) < 1) {
         (void)fclose(file);
         return HDF_FAILURE;
     }
     (void)fclose(file);
+    entry.fixture.frame = entry.storage.data();
+    entry.fixture.frameSize = readSize;
+    return HDF_SUCCESS;
+}
+
+/* a period of the reference tone standing in for the wav data when AUDIO_SOURCE_SYNTH is set */
+int32_t SynthPcmFixture(const struct AudioSampleAttributes &attrs, PcmFixtureEntry &entry)
+{
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    PcmSynthDefault(params, AUDIO_SYNTH_SWEEP);
+    params.startHz = SYNTH_TONE_HZ;
+    params.endHz = SYNTH_TONE_HZ;
+    if (PcmSynthInit(synth, attrs, params) < 0) {
+        return HDF_FAILURE;
+    }
+    entry.fixture = {};
+    entry.fixture.attrs = attrs;
+    entry.storage.resize(attrs.period);
+    uint64_t readSize = PcmSynthFill(synth, entry.storage.data(), entry.storage.size());
+    if (readSize == 0) {
+        return HDF_FAILURE;
+    }
+    entry.storage.resize(readSize);
+    entry.fixture.headInfo.audioChannelNum = attrs.channelCount;
+    entry.fixture.headInfo.audioSampleRate = attrs.sampleRate;
+    entry.fixture.headInfo.audioBitsPerSample = PcmFormatToBits(attrs.format);
+    entry.fixture.headInfo.dataSize = readSize;
+    entry.fixture.frame = entry.storage.data();
+    entry.fixture.frameSize = readSize;
+    return HDF_SUCCESS;
+}
+}
+
+bool SynthSourceForced()
+{
+    static const bool forced = getenv("AUDIO_SOURCE_SYNTH") != nullptr;
+    return forced;
+}
+
+int32_t GetPcmFixture(const std::string &path, const struct AudioSampleAttributes &attrs,
+    const struct AudioPcmFixture *&fixture)
+{
+    int32_t ret = -1;
+    std::string key = PcmFixtureKey(path, attrs);
+    std::lock_guard<std::mutex> lock(g_fixtureMutex);
+    auto iter = g_fixtureCache.find(key);
+    if (iter == g_fixtureCache.end()) {
+        std::unique_ptr<PcmFixtureEntry> entry = std::make_unique<PcmFixtureEntry>();
+        /* a missing fixture is a failure; the generator stands in only when AUDIO_SOURCE_SYNTH asks for it */
+        ret = SynthSourceForced() ? SynthPcmFixture(attrs, *entry) : LoadPcmFixture(path, attrs, *entry);
+        if (ret < 0) {
+            return HDF_FAILURE;
+        }
+        iter = g_fixtureCache.emplace(key, std::move(entry)).first;
+    }
+    fixture = &iter->second->fixture;
+    return HDF_SUCCESS;
+}
+
+int32_t RenderFramePrepare(const std::string &path, char *&frame, uint64_t &readSize)
+{
+    struct AudioSampleAttributes attrs = {};
+    const struct AudioPcmFixture *fixture = nullptr;
+    InitAttrs(attrs);
+    if (GetPcmFixture(path, attrs, fixture) < 0) {
+        return HDF_FAILURE;
+    }
+    frame = (char *)calloc(1, fixture->frameSize);
+    if (frame == nullptr) {
+        return HDF_ERR_MALLOC_FAIL;
+    }
+    std::copy(fixture->frame, fixture->frame + fixture->frameSize, frame);
+    readSize = fixture->frameSize;
     return HDF_SUCCESS;
 }
 
 void FrameStatus(int status)
 {
-    g_frameStatus = status;
+    {
+        std::lock_guard<std::mutex> lock(g_frameStatusMutex);
+        g_frameStatus = status;
+    }
+    g_frameStatusCond.notify_all();
     return;
 }
 
-int32_t StartRecord(struct AudioCapture *capture, FILE *file, uint64_t filesize)
+namespace {
+struct RecordSlot {
+    char *data = nullptr;
+    uint64_t length = 0;
+};
+
+/* ring of preallocated capture periods; the capture thread fills slots and a writer thread drains them */
+class RecordWriter {
+public:
+    RecordWriter(int fd, uint64_t bufferSize, struct AudioRecordStats &stats)
+        : fd_(fd), bufferSize_(bufferSize), stats_(stats) {}
+    ~RecordWriter()
+    {
+        Finish();
+        for (int index = 0; index < RECORD_RING_DEPTH; index++) {
+            free(slots_[index].data);
+        }
+        free(dropBuffer_);
+    }
+
+    bool Init()
+    {
+        for (int index = 0; index < RECORD_RING_DEPTH; index++) {
+            if (posix_memalign(reinterpret_cast<void **>(&slots_[index].data), RECORD_BUFFER_ALIGN, bufferSize_)) {
+                return false;
+            }
+        }
+        if (posix_memalign(reinterpret_cast<void **>(&dropBuffer_), RECORD_BUFFER_ALIGN, bufferSize_)) {
+            return false;
+        }
+        EnableDirectIo();
+        writer_ = std::thread([this] { Run(); });
+        return true;
+    }
+
+    /* never blocks: when the writer still owns every slot the period lands in the drop buffer */
+    char *AcquireSlot(bool &dropped)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropped = (pending_ == RECORD_RING_DEPTH);
+        return dropped ? dropBuffer_ : slots_[head_].data;
+    }
+
+    void CommitSlot(bool dropped, uint64_t length)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.capturedBytes += length;
+        if (dropped) {
+            stats_.overruns++;
+            stats_.droppedBytes += length;
+            return;
+        }
+        slots_[head_].length = length;
+        head_ = (head_ + 1) % RECORD_RING_DEPTH;
+        pending_++;
+        cond_.notify_one();
+    }
+
+    void Finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ = true;
+        }
+        cond_.notify_one();
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+        DisableDirectIo();
+    }
+
+private:
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cond_.wait(lock, [this] { return pending_ > 0 || finished_; });
+            if (pending_ == 0) {
+                return;
+            }
+            struct RecordSlot &slot = slots_[tail_];
+            lock.unlock();
+            bool written = WriteSlot(slot);
+            lock.lock();
+            stats_.writtenBytes += written ? slot.length : 0;
+            stats_.writeErrors += written ? 0 : 1;
+            tail_ = (tail_ + 1) % RECORD_RING_DEPTH;
+            pending_--;
+        }
+    }
+
+    bool WriteSlot(const struct RecordSlot &slot)
+    {
+        uint64_t offset = 0;
+        while (offset < slot.length) {
+            ssize_t ret = write(fd_, slot.data + offset, slot.length - offset);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret < 0 && errno == EINVAL && directActive_) {
+                DisableDirectIo(); // short periods are not block aligned, finish with buffered writes
+                continue;
+            }
+            if (ret <= 0) {
+                return false;
+            }
+            offset += static_cast<uint64_t>(ret);
+        }
+        return true;
+    }
+
+    void EnableDirectIo()
+    {
+#ifdef O_DIRECT
+        int flags = fcntl(fd_, F_GETFL);
+        if (flags >= 0 && bufferSize_ % RECORD_BUFFER_ALIGN == 0 && fcntl(fd_, F_SETFL, flags | O_DIRECT) == 0) {
+            directActive_ = true;
+            stats_.directIo = true;
+        }
+#endif
+    }
+
+    void DisableDirectIo()
+    {
+#ifdef O_DIRECT
+        if (!directActive_) {
+            return;
+        }
+        int flags = fcntl(fd_, F_GETFL);
+        if (flags >= 0) {
+            (void)fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+        }
+        directActive_ = false;
+#endif
+    }
+
+    int fd_;
+    uint64_t bufferSize_;
+    struct AudioRecordStats &stats_;
+    struct RecordSlot slots_[RECORD_RING_DEPTH];
+    char *dropBuffer_ = nullptr;
+    int head_ = 0;
+    int tail_ = 0;
+    int pending_ = 0;
+    bool finished_ = false;
+    bool directActive_ = false;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread writer_;
+};
+}
+
+int32_t StartRecordPipeline(struct AudioCapture *capture, FILE *file, uint64_t filesize,
+    struct AudioRecordStats &stats)
 {
     uint64_t replyBytes = 0;
     uint64_t requestBytes = BUFFER_LENTH;
-    uint64_t totalSize = 0;
     int32_t tryNumFrame = 0;
+    bool dropped = false;
+    stats = {};
     if (capture == nullptr || capture->control.Start == nullptr ||
         capture->CaptureFrame == nullptr || file == nullptr) {
         return AUDIO_HAL_ERR_INVALID_PARAM;
     }
+    int fd = fileno(file);
+    if (fd < 0 || fflush(file) != 0) {
+        return HDF_FAILURE;
+    }
     int32_t ret = capture->control.Start((AudioHandle)capture);
     if (ret < 0) {
         return ret;
     }
-    char *frame = (char *)calloc(1, BUFFER_LENTH);
-    if (frame == nullptr) {
+    RecordWriter writer(fd, BUFFER_LENTH, stats);
+    if (!writer.Init()) {
         return HDF_ERR_MALLOC_FAIL;
     }
+    struct AudioSampleAttributes attrs = {};
+    struct AudioPcmVerifier verifier = {};
+    bool verify = capture->attr.GetSampleAttributes != nullptr &&
+        capture->attr.GetSampleAttributes(capture, &attrs) == AUDIO_HAL_SUCCESS &&
+        PcmVerifyInit(verifier, attrs, 0) == AUDIO_HAL_SUCCESS;
     do {
-        if (g_frameStatus) {
-            ret = capture->CaptureFrame(capture, frame, requestBytes, &replyBytes);
-            if (ret < 0) {
-                if (ret == -1) {
-                    if (tryNumFrame++ > TRY_NUM_FRAME) {
-                        free(frame);
-                        frame = nullptr;
-                        return ret;
-                    }
-                    continue;
+        WaitFrameStatus();
+        char *frame = writer.AcquireSlot(dropped);
+        ret = capture->CaptureFrame(capture, frame, requestBytes, &replyBytes);
+        if (ret < 0) {
+            if (ret == -1) {
+                if (tryNumFrame++ > TRY_NUM_FRAME) {
+                    return ret;
                 }
-                free(frame);
-                frame = nullptr;
-                return ret;
-            }
-            tryNumFrame = 0;
-            uint32_t replyByte = static_cast<uint32_t>(replyBytes);
-            size_t writeRet = fwrite(frame, replyByte, 1, file);
-            if (writeRet < 0) {
-                free(frame);
-                frame = nullptr;
-                return HDF_FAILURE;
+                continue;
             }
-            totalSize += replyBytes;
-        } else {
-            totalSize += 0;
+            return ret;
         }
-    } while (totalSize <= filesize * MEGABYTE);
-    free(frame);
-    frame = nullptr;
-    return AUDIO_HAL_SUCCESS;
+        tryNumFrame = 0;
+        if (verify) {
+            PcmVerifyFeed(verifier, frame, replyBytes);
+        }
+        writer.CommitSlot(dropped, replyBytes);
+    } while (stats.capturedBytes <= filesize * MEGABYTE);
+    writer.Finish();
+    PcmVerifyResult(verifier, stats.pcm);
+    (void)fseek(file, 0, SEEK_END);
+    return stats.writeErrors == 0 ? AUDIO_HAL_SUCCESS : HDF_FAILURE;
+}
+
+void RecordStatsPrint(const char *label, const struct AudioRecordStats &stats)
+{
+    printf("%s: captured=%llu written=%llu overruns=%llu dropped=%llu writeErrors=%llu directIo=%d\n", label,
+        (unsigned long long)stats.capturedBytes, (unsigned long long)stats.writtenBytes,
+        (unsigned long long)stats.overruns, (unsigned long long)stats.droppedBytes,
+        (unsigned long long)stats.writeErrors, stats.directIo);
+}
+
+int32_t StartRecord(struct AudioCapture *capture, FILE *file, uint64_t filesize)
+{
+    struct AudioRecordStats stats = {};
+    return StartRecordPipeline(capture, file, filesize, stats);
 }
 
 int32_t WriteIdToBuf(struct HdfSBuf *sBuf, struct AudioCtlElemId id)
@@ -668,96 +1573,168 @@ int32_t WriteEleValueToBuf(struct HdfSBuf *sBuf, struct AudioCtlElemValue elemva
     return HDF_SUCCESS;
 }
 
-int32_t ChangeRegisterStatus(struct AudioCtlElemValue elemValue)
+static struct HdfSBuf *ControlSessionObtain(struct AudioControlSession &session)
 {
-    int32_t ret = -1;
-    struct HdfIoService *service = nullptr;
-    struct HdfSBuf *reply = nullptr;
-    struct HdfSBuf *sBuf = nullptr;
-    service = HdfIoServiceBind(HDF_CONTROL_SERVICE.c_str());
-    if (service == nullptr || service->dispatcher == nullptr) {
-        return HDF_FAILURE;
+    if (session.pooled == 0) {
+        return HdfSbufObtainDefaultSize();
     }
-    sBuf = HdfSbufObtainDefaultSize();
+    struct HdfSBuf *sBuf = session.sBufPool[--session.pooled];
+    HdfSbufFlush(sBuf);
+    return sBuf;
+}
+
+static void ControlSessionRecycle(struct AudioControlSession &session, struct HdfSBuf *sBuf)
+{
     if (sBuf == nullptr) {
-        HdfIoServiceRecycle(service);
-        return HDF_FAILURE;
+        return;
     }
-    ret = WriteEleValueToBuf(sBuf, elemValue);
-    if (ret < 0) {
+    if (session.pooled == CONTROL_SBUF_POOL_SIZE) {
         HdfSbufRecycle(sBuf);
-        HdfIoServiceRecycle(service);
-        return HDF_FAILURE;
+        return;
     }
-    ret = service->dispatcher->Dispatch(&service->object, AUDIODRV_CTRL_IOCTRL_ELEM_WRITE, sBuf, reply);
-    if (ret < 0) {
-        HdfSbufRecycle(sBuf);
-        HdfIoServiceRecycle(service);
-        return ret;
+    session.sBufPool[session.pooled++] = sBuf;
+}
+
+int32_t ControlSessionOpen(struct AudioControlSession &session)
+{
+    session = {};
+    session.service = HdfIoServiceBind(HDF_CONTROL_SERVICE.c_str());
+    if (session.service == nullptr || session.service->dispatcher == nullptr) {
+        ControlSessionClose(session);
+        return HDF_FAILURE;
     }
-    HdfSbufRecycle(sBuf);
-    HdfIoServiceRecycle(service);
     return HDF_SUCCESS;
 }
 
-int32_t QueryRegisterStatus(struct AudioCtlElemId id, struct AudioCtlElemValue &elemValue)
+void ControlSessionClose(struct AudioControlSession &session)
+{
+    while (session.pooled > 0) {
+        HdfSbufRecycle(session.sBufPool[--session.pooled]);
+    }
+    if (session.service != nullptr) {
+        HdfIoServiceRecycle(session.service);
+        session.service = nullptr;
+    }
+}
+
+int32_t ControlSessionWrite(struct AudioControlSession &session, const struct AudioCtlElemValue &elemValue)
+{
+    return ControlSessionWriteBatch(session, &elemValue, 1);
+}
+
+/* the control service decodes one element per ELEM_WRITE, so a batch is a run of dispatches on one sbuf */
+int32_t ControlSessionWriteBatch(struct AudioControlSession &session, const struct AudioCtlElemValue *elemValues,
+    uint32_t count)
 {
-    struct HdfIoService *service = nullptr;
-    struct HdfSBuf *sBuf = nullptr;
-    struct HdfSBuf *reply = nullptr;
     int32_t ret = -1;
-    service = HdfIoServiceBind(HDF_CONTROL_SERVICE.c_str());
-    if (service == nullptr || service->dispatcher == nullptr) {
+    if (session.service == nullptr || session.service->dispatcher == nullptr || elemValues == nullptr) {
         return HDF_FAILURE;
     }
-    sBuf = HdfSbufObtainDefaultSize();
+    struct HdfSBuf *sBuf = ControlSessionObtain(session);
     if (sBuf == nullptr) {
-        HdfIoServiceRecycle(service);
         return HDF_FAILURE;
     }
-    ret = WriteIdToBuf(sBuf, id);
-    if (ret < 0) {
-        HdfSbufRecycle(sBuf);
-        HdfIoServiceRecycle(service);
+    for (uint32_t index = 0; index < count; index++) {
+        if (index > 0) {
+            HdfSbufFlush(sBuf);
+        }
+        ret = WriteEleValueToBuf(sBuf, elemValues[index]);
+        if (ret < 0) {
+            ControlSessionRecycle(session, sBuf);
+            return HDF_FAILURE;
+        }
+        ret = session.service->dispatcher->Dispatch(&session.service->object, AUDIODRV_CTRL_IOCTRL_ELEM_WRITE,
+            sBuf, nullptr);
+        if (ret < 0) {
+            ControlSessionRecycle(session, sBuf);
+            return ret;
+        }
+    }
+    ControlSessionRecycle(session, sBuf);
+    return HDF_SUCCESS;
+}
+
+int32_t ControlSessionRead(struct AudioControlSession &session, const struct AudioCtlElemId &id,
+    struct AudioCtlElemValue &elemValue)
+{
+    int32_t ret = -1;
+    if (session.service == nullptr || session.service->dispatcher == nullptr) {
         return HDF_FAILURE;
     }
-    reply = HdfSbufObtainDefaultSize();
-    if (reply == nullptr) {
-        HdfSbufRecycle(sBuf);
-        HdfIoServiceRecycle(service);
+    struct HdfSBuf *sBuf = ControlSessionObtain(session);
+    struct HdfSBuf *reply = ControlSessionObtain(session);
+    if (sBuf == nullptr || reply == nullptr) {
+        ControlSessionRecycle(session, sBuf);
+        ControlSessionRecycle(session, reply);
         return HDF_FAILURE;
     }
-    ret = service->dispatcher->Dispatch(&service->object, AUDIODRV_CTRL_IOCTRL_ELEM_READ, sBuf, reply);
-    if (ret < 0) {
-        HdfSbufRecycle(sBuf);
-        HdfSbufRecycle(reply);
-        HdfIoServiceRecycle(service);
-        return ret;
+    ret = WriteIdToBuf(sBuf, id);
+    if (ret == HDF_SUCCESS) {
+        ret = session.service->dispatcher->Dispatch(&session.service->object, AUDIODRV_CTRL_IOCTRL_ELEM_READ,
+            sBuf, reply);
     }
-    if (!HdfSbufReadInt32(reply, &elemValue.value[0])) {
-        HdfSbufRecycle(sBuf);
-        HdfSbufRecycle(reply);
-        HdfIoServiceRecycle(service);
+    if (ret == HDF_SUCCESS && !HdfSbufReadInt32(reply, &elemValue.value[0])) {
+        ret = HDF_FAILURE;
+    }
+    ControlSessionRecycle(session, sBuf);
+    ControlSessionRecycle(session, reply);
+    return ret < 0 ? ret : HDF_SUCCESS;
+}
+
+namespace {
+std::mutex g_controlSessionMutex;
+std::once_flag g_controlSessionExit;
+struct AudioControlSession g_controlSession = {};
+
+/*
+ * the register helpers share one session that stays bound until ReleaseControlSession; suites release it in
+ * TearDownTestCase, and whatever is still bound when the process exits is released then
+ */
+struct AudioControlSession *AcquireControlSession()
+{
+    if (g_controlSession.service == nullptr && ControlSessionOpen(g_controlSession) != HDF_SUCCESS) {
+        return nullptr;
+    }
+    std::call_once(g_controlSessionExit, []() { (void)atexit(ReleaseControlSession); });
+    return &g_controlSession;
+}
+}
+
+void ReleaseControlSession()
+{
+    std::lock_guard<std::mutex> lock(g_controlSessionMutex);
+    ControlSessionClose(g_controlSession);
+}
+
+int32_t ChangeRegisterStatus(struct AudioCtlElemValue elemValue)
+{
+    std::lock_guard<std::mutex> lock(g_controlSessionMutex);
+    struct AudioControlSession *session = AcquireControlSession();
+    if (session == nullptr) {
         return HDF_FAILURE;
     }
-    HdfSbufRecycle(sBuf);
-    HdfSbufRecycle(reply);
-    HdfIoServiceRecycle(service);
-    return HDF_SUCCESS;
+    return ControlSessionWrite(*session, elemValue);
 }
 
-int32_t PowerOff(struct AudioCtlElemValue firstElemValue, struct AudioCtlElemValue secondElemValue)
+int32_t QueryRegisterStatus(struct AudioCtlElemId id, struct AudioCtlElemValue &elemValue)
 {
-    int32_t ret = -1;
-    ret = ChangeRegisterStatus(firstElemValue);
-    if (ret < 0) {
-        return ret;
+    std::lock_guard<std::mutex> lock(g_controlSessionMutex);
+    struct AudioControlSession *session = AcquireControlSession();
+    if (session == nullptr) {
+        return HDF_FAILURE;
     }
-    ret = ChangeRegisterStatus(secondElemValue);
-    if (ret < 0) {
-        return ret;
+    return ControlSessionRead(*session, id, elemValue);
+}
+
+int32_t PowerOff(struct AudioCtlElemValue firstElemValue, struct AudioCtlElemValue secondElemValue)
+{
+    struct AudioCtlElemValue elemValues[2] = { firstElemValue, secondElemValue }; // 2: both power registers
+    std::lock_guard<std::mutex> lock(g_controlSessionMutex);
+    struct AudioControlSession *session = AcquireControlSession();
+    if (session == nullptr) {
+        return HDF_FAILURE;
     }
-    return HDF_SUCCESS;
+    return ControlSessionWriteBatch(*session, elemValues, sizeof(elemValues) / sizeof(elemValues[0]));
 }
 
 int32_t CheckRegisterStatus(const struct AudioCtlElemId firstId, const struct AudioCtlElemId secondId,
@@ -765,14 +1742,19 @@ int32_t CheckRegisterStatus(const struct AudioCtlElemId firstId, const struct Au
 {
     int32_t ret = -1;
     struct AudioCtlElemValue elemValue[2] = {{}, {}};
-    ret = QueryRegisterStatus(firstId, elemValue[0]);
+    std::lock_guard<std::mutex> lock(g_controlSessionMutex);
+    struct AudioControlSession *session = AcquireControlSession();
+    if (session == nullptr) {
+        return HDF_FAILURE;
+    }
+    ret = ControlSessionRead(*session, firstId, elemValue[0]);
     if (ret < 0) {
         return ret;
     }
     if (firstStatus != elemValue[0].value[0]) {
         return HDF_FAILURE;
     }
-    ret = QueryRegisterStatus(secondId, elemValue[1]);
+    ret = ControlSessionRead(*session, secondId, elemValue[1]);
     if (ret < 0) {
         return ret;
     }
@@ -789,7 +1771,7 @@ int32_t StopAudio(struct PrepareAudioPara &audiopara)
         ret = audiopara.capture->control.Stop((AudioHandle)(audiopara.capture));
         if (ret < 0) {
             audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-            audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+            ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
             audiopara.capture = nullptr;
             audiopara.adapter = nullptr;
             return ret;
@@ -803,7 +1785,7 @@ int32_t StopAudio(struct PrepareAudioPara &audiopara)
         ret = audiopara.render->control.Stop((AudioHandle)(audiopara.render));
         if (ret < 0) {
             audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-            audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+            ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
             audiopara.render = nullptr;
             audiopara.adapter = nullptr;
             return ret;
@@ -812,7 +1794,7 @@ int32_t StopAudio(struct PrepareAudioPara &audiopara)
         audiopara.render = nullptr;
     }
     if (audiopara.manager != nullptr && audiopara.adapter != nullptr) {
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         audiopara.adapter = nullptr;
     }
     return AUDIO_HAL_SUCCESS;
@@ -834,16 +1816,84 @@ int32_t ThreadRelease(struct PrepareAudioPara &audiopara)
     return AUDIO_HAL_SUCCESS;
 }
 
+static int32_t PlayMappedAudioFile(struct PrepareAudioPara &audiopara)
+{
+    struct AudioWavMapping mapping = {};
+    int32_t ret = WavMapOpen(audiopara.path, mapping, audiopara.headInfo, audiopara.attrs);
+    if (ret < 0) {
+        return HDF_FAILURE;
+    }
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    if (ret < 0) {
+        WavMapClose(mapping);
+        return ret;
+    }
+    if (audiopara.render == nullptr) {
+        WavMapClose(mapping);
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    ret = FrameStartMmap(audiopara.render, mapping, audiopara.attrs);
+    WavMapClose(mapping);
+    if (ret != AUDIO_HAL_SUCCESS) {
+        audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+        audiopara.render = nullptr;
+        audiopara.adapter = nullptr;
+        return ret;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* SYNTH_PLAY_SECONDS of the default sweep in the InitAttrs format */
+static int32_t PlaySynthAudio(struct PrepareAudioPara &audiopara)
+{
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    InitAttrs(audiopara.attrs);
+    PcmSynthDefault(params, AUDIO_SYNTH_SWEEP);
+    int32_t ret = PcmSynthInit(synth, audiopara.attrs, params);
+    if (ret < 0) {
+        return ret;
+    }
+    audiopara.headInfo = {};
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    if (ret < 0) {
+        return ret;
+    }
+    if (audiopara.render == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    uint64_t frames = static_cast<uint64_t>(audiopara.attrs.sampleRate) * SYNTH_PLAY_SECONDS;
+    ret = FrameStartSynth(audiopara.render, synth, audiopara.attrs, frames);
+    if (ret != AUDIO_HAL_SUCCESS) {
+        audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+        audiopara.render = nullptr;
+        audiopara.adapter = nullptr;
+        return ret;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
 int32_t PlayAudioFile(struct PrepareAudioPara &audiopara)
 {
     int32_t ret = -1;
     char absPath[PATH_MAX] = {0};
-    if (realpath(audiopara.path, absPath) == nullptr) {
-        return HDF_FAILURE;
-    }
     if (audiopara.manager == nullptr) {
         return AUDIO_HAL_ERR_INVALID_PARAM;
     }
+    /* the mapping test always reads the file; the others take the generator when asked for it */
+    if (audiopara.source == AUDIO_SOURCE_MMAP) {
+        return PlayMappedAudioFile(audiopara);
+    }
+    if (audiopara.source == AUDIO_SOURCE_SYNTH || SynthSourceForced()) {
+        return PlaySynthAudio(audiopara);
+    }
+    if (realpath(audiopara.path, absPath) == nullptr) {
+        return HDF_FAILURE;
+    }
     FILE *file = fopen(absPath, "rb");
     if (file == nullptr) {
         return HDF_FAILURE;
@@ -867,7 +1917,7 @@ int32_t PlayAudioFile(struct PrepareAudioPara &audiopara)
         (void)fclose(file);
     } else {
         audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         audiopara.render = nullptr;
         audiopara.adapter = nullptr;
         (void)fclose(file);
@@ -895,20 +1945,20 @@ int32_t RecordAudio(struct PrepareAudioPara &audiopara)
     ret = audiopara.capture->volume.SetMute(audiopara.capture, isMute);
     if (ret < 0) {
         audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         return ret;
     }
 
     FILE *file = fopen(audiopara.path, "wb+");
     if (file == nullptr) {
         audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         return AUDIO_HAL_ERR_INTERNAL;
     }
-    ret = StartRecord(audiopara.capture, file, audiopara.fileSize);
+    ret = StartRecordPipeline(audiopara.capture, file, audiopara.fileSize, audiopara.recordStats);
     if (ret < 0) {
         audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         audiopara.capture = nullptr;
         audiopara.adapter = nullptr;
         (void)fclose(file);
@@ -1010,6 +2060,145 @@ int32_t RecordMapAudio(struct PrepareAudioPara &audiopara)
     return ret;
 }
 
+namespace {
+struct MmapPositionSample {
+    uint64_t frames;
+    int64_t monotonicNs;
+};
+
+void MmapStreamAnalyze(const std::vector<struct MmapPositionSample> &samples, const struct AudioSampleAttributes &attrs,
+    int32_t transferFrameSize, struct AudioMmapStreamStats &stats)
+{
+    stats = {};
+    stats.polls = samples.size();
+    if (samples.empty() || attrs.sampleRate == 0) {
+        return;
+    }
+    stats.frames = samples.back().frames;
+    size_t first = 0;
+    while (first < samples.size() && samples[first].frames == samples[0].frames) {
+        first++;
+    }
+    size_t last = first;
+    while (last + 1 < samples.size() && samples[last].frames < stats.frames) {
+        last++;
+    }
+    if (first >= samples.size() || last <= first) {
+        return;
+    }
+    const struct MmapPositionSample &start = samples[first];
+    const struct MmapPositionSample &end = samples[last];
+    uint64_t frameBytes = attrs.channelCount * (PcmFormatToBits(attrs.format) >> MOVE_RIGHT_NUM);
+    double frameNs = static_cast<double>(SECTONSEC) / attrs.sampleRate;
+    int64_t transferNs = static_cast<int64_t>(transferFrameSize * frameNs);
+    stats.elapsedNs = end.monotonicNs - start.monotonicNs;
+    double framesPerNs = static_cast<double>(end.frames - start.frames) / stats.elapsedNs;
+    stats.bytesPerSecond = framesPerNs * frameBytes * SECTONSEC;
+    stats.driftPpm = (framesPerNs * frameNs - 1) * MICROSECOND;
+    int64_t changedNs = start.monotonicNs;
+    bool stalled = false;
+    for (size_t index = first; index <= last; index++) {
+        const struct MmapPositionSample &sample = samples[index];
+        double expectedFrames = start.frames + (sample.monotonicNs - start.monotonicNs) / frameNs;
+        int64_t lagNs = static_cast<int64_t>(std::fabs(expectedFrames - sample.frames) * frameNs);
+        stats.maxLagNs = lagNs > stats.maxLagNs ? lagNs : stats.maxLagNs;
+        if (index > first && sample.frames != samples[index - 1].frames) {
+            changedNs = sample.monotonicNs;
+            stalled = false;
+        } else if (!stalled && sample.monotonicNs - changedNs > transferNs) {
+            stats.stalls++;
+            stalled = true;
+        }
+    }
+}
+
+/* ReqMmapBuffer streams the whole mapping before it returns, so the position is sampled from this thread meanwhile */
+int32_t MmapStreamTransfer(AudioHandle handle, const struct AudioAttribute &attr, FILE *fp, bool isRender,
+    struct AudioMmapStreamStats &stats)
+{
+    int32_t reqSize = 0;
+    struct AudioMmapBufferDescripter desc = {};
+    struct AudioSampleAttributes attrs = {};
+    struct AudioTimeStamp time = {};
+    if (attr.GetSampleAttributes == nullptr || attr.ReqMmapBuffer == nullptr || attr.GetMmapPosition == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    int32_t ret = attr.GetSampleAttributes(handle, &attrs);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = InitMmapDesc(fp, desc, reqSize, isRender);
+    if (ret < 0) {
+        return HDF_FAILURE;
+    }
+    std::vector<struct MmapPositionSample> samples;
+    std::atomic<bool> finished(false);
+    int32_t transferRet = HDF_FAILURE;
+    std::thread transfer([&] {
+        transferRet = attr.ReqMmapBuffer(handle, reqSize, &desc);
+        finished = true;
+    });
+    do {
+        struct MmapPositionSample sample = {};
+        if (attr.GetMmapPosition(handle, &sample.frames, &time) == AUDIO_HAL_SUCCESS) {
+            sample.monotonicNs = GetMonotonicNs();
+            samples.push_back(sample);
+        }
+        usleep(MMAP_POLL_INTERVAL_US);
+    } while (!finished);
+    transfer.join();
+    if (transferRet == AUDIO_HAL_SUCCESS) {
+        munmap(desc.memoryAddress, reqSize);
+    }
+    MmapStreamAnalyze(samples, attrs, desc.transferFrameSize, stats);
+    return transferRet;
+}
+}
+
+int32_t PlayMmapStream(struct PrepareAudioPara &audiopara, struct AudioMmapStreamStats &stats)
+{
+    int32_t ret = -1;
+    if (audiopara.render == nullptr) {
+        return HDF_FAILURE;
+    }
+    char absPath[PATH_MAX] = {0};
+    if (realpath(audiopara.path, absPath) == nullptr) {
+        return HDF_FAILURE;
+    }
+    FILE *fp = fopen(absPath, "rb+");
+    if (!fp) {
+        return HDF_FAILURE;
+    }
+    ret = audiopara.render->control.Start((AudioHandle)(audiopara.render));
+    if (ret < 0) {
+        (void)fclose(fp);
+        return ret;
+    }
+    ret = MmapStreamTransfer((AudioHandle)(audiopara.render), audiopara.render->attr, fp, true, stats);
+    (void)fclose(fp);
+    return ret;
+}
+
+int32_t RecordMmapStream(struct PrepareAudioPara &audiopara, struct AudioMmapStreamStats &stats)
+{
+    int32_t ret = -1;
+    if (audiopara.capture == nullptr) {
+        return HDF_FAILURE;
+    }
+    FILE *fp = fopen(audiopara.path, "wb+");
+    if (!fp) {
+        return HDF_FAILURE;
+    }
+    ret = audiopara.capture->control.Start((AudioHandle)(audiopara.capture));
+    if (ret < 0) {
+        (void)fclose(fp);
+        return ret;
+    }
+    ret = MmapStreamTransfer((AudioHandle)(audiopara.capture), audiopara.capture->attr, fp, false, stats);
+    (void)fclose(fp);
+    return ret;
+}
+
 int32_t AudioRenderCallback(enum AudioCallbackType type, void *reserved, void *cookie)
 {
     switch (type) {
@@ -1031,6 +2220,57 @@ int32_t AudioRenderCallback(enum AudioCallbackType type, void *reserved, void *c
     }
 }
 
+/* keeps the globals the RegCallback tests poll, and timestamps the event into the queue given as cookie */
+int32_t AudioRenderEventCallback(enum AudioCallbackType type, void *reserved, void *cookie)
+{
+    int64_t timestampNs = GetMonotonicNs();
+    int32_t ret = AudioRenderCallback(type, reserved, cookie);
+    struct AudioRenderEventQueue *queue = static_cast<struct AudioRenderEventQueue *>(cookie);
+    if (queue == nullptr) {
+        return ret;
+    }
+    uint32_t head = queue->head.load(std::memory_order_relaxed);
+    if (head - queue->tail.load(std::memory_order_acquire) == RENDER_EVENT_QUEUE_DEPTH) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        return ret;
+    }
+    queue->events[head % RENDER_EVENT_QUEUE_DEPTH].type = type;
+    queue->events[head % RENDER_EVENT_QUEUE_DEPTH].timestampNs = timestampNs;
+    queue->head.store(head + 1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+    }
+    queue->pushed.notify_one();
+    return ret;
+}
+
+void RenderEventQueueInit(struct AudioRenderEventQueue &queue)
+{
+    queue.head.store(0, std::memory_order_relaxed);
+    queue.tail.store(0, std::memory_order_relaxed);
+    queue.dropped.store(0, std::memory_order_relaxed);
+}
+
+bool RenderEventQueuePop(struct AudioRenderEventQueue &queue, struct AudioRenderEvent &event)
+{
+    uint32_t tail = queue.tail.load(std::memory_order_relaxed);
+    if (tail == queue.head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = queue.events[tail % RENDER_EVENT_QUEUE_DEPTH];
+    queue.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool RenderEventQueueWait(struct AudioRenderEventQueue &queue, int64_t deadlineNs)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    int64_t remainingNs = deadlineNs - GetMonotonicNs();
+    return queue.pushed.wait_for(lock, std::chrono::nanoseconds(remainingNs > 0 ? remainingNs : 0), [&queue]() {
+        return queue.tail.load(std::memory_order_relaxed) != queue.head.load(std::memory_order_acquire);
+    });
+}
+
 int32_t CheckWriteCompleteValue()
 {
     if (g_writeCompleted == AUDIO_WRITE_COMPELETED_VALUE)
@@ -0,0 +1,294 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_pcm_synth.h
+ *
+ * @brief Implements the synthetic PCM generator used in place of the on-device wav fixtures.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "audio_hdi_common.h"
+#include "audio_hdi_pcm_synth.h"
+
+namespace HMOS {
+namespace Audio {
+namespace {
+const float FULL_SCALE_8_BIT = 127.0f;
+const float FULL_SCALE_16_BIT = 32767.0f;
+const double FULL_SCALE_24_BIT = 8388607.0;
+const double FULL_SCALE_32_BIT = 2147483647.0;
+const uint32_t BITS_PER_BYTE = 8;
+const int UNSIGNED_8_BIT_ZERO = 128;
+/* interleaved samples synthesized per pass; a multiple of the noise and sweep lanes and of the SIMD width */
+const size_t SYNTH_BLOCK_SAMPLES = 512;
+const size_t SYNTH_SWEEP_LANES = 4;
+const int SIMD_LANES_16_BIT = 8;
+const double PI = 3.14159265358979323846;
+const double NYQUIST_MARGIN = 0.45;
+const uint32_t NOISE_SHIFT_LEFT = 13;
+const uint32_t NOISE_SHIFT_RIGHT = 17;
+const uint32_t NOISE_SHIFT_FINAL = 5;
+const uint32_t NOISE_SEED_STEP = 0x9E3779B9;
+const float NOISE_SCALE = 1.0f / 2147483648.0f;
+
+inline float Clamp(float value)
+{
+    return value > 1.0f ? 1.0f : (value < -1.0f ? -1.0f : value);
+}
+
+/* xorshift32 in independent lanes, laid out so the loop vectorizes */
+void SynthNoise(struct AudioPcmSynth &synth, float *block, size_t count)
+{
+    float amplitude = static_cast<float>(synth.params.amplitude);
+    for (size_t done = 0; done < count; done += SYNTH_NOISE_LANES) {
+        for (uint32_t lane = 0; lane < SYNTH_NOISE_LANES; lane++) {
+            uint32_t state = synth.noise[lane];
+            state ^= state << NOISE_SHIFT_LEFT;
+            state ^= state >> NOISE_SHIFT_RIGHT;
+            state ^= state << NOISE_SHIFT_FINAL;
+            synth.noise[lane] = state;
+            block[done + lane] = static_cast<float>(static_cast<int32_t>(state)) * NOISE_SCALE * amplitude;
+        }
+    }
+}
+
+/*
+ * the frequency is held for one block. SYNTH_SWEEP_LANES oscillators, each a frame apart in phase, step
+ * SYNTH_SWEEP_LANES frames at a time, so the rotations in the inner loop are independent and it vectorizes
+ */
+void SynthSweep(struct AudioPcmSynth &synth, float *mono, size_t frames)
+{
+    double step = 2 * PI * synth.frequency / synth.sampleRate; // 2: a full turn of the oscillator
+    double laneCos[SYNTH_SWEEP_LANES];
+    double laneSin[SYNTH_SWEEP_LANES];
+    for (size_t lane = 0; lane < SYNTH_SWEEP_LANES; lane++) {
+        double offsetCos = std::cos(step * lane);
+        double offsetSin = std::sin(step * lane);
+        laneCos[lane] = synth.phaseCos * offsetCos - synth.phaseSin * offsetSin;
+        laneSin[lane] = synth.phaseSin * offsetCos + synth.phaseCos * offsetSin;
+    }
+    double stepCos = std::cos(step * SYNTH_SWEEP_LANES);
+    double stepSin = std::sin(step * SYNTH_SWEEP_LANES);
+    double amplitude = synth.params.amplitude;
+    /* mono holds SYNTH_BLOCK_SAMPLES, a multiple of the lanes, so the last pass may run past frames */
+    for (size_t frame = 0; frame < frames; frame += SYNTH_SWEEP_LANES) {
+        for (size_t lane = 0; lane < SYNTH_SWEEP_LANES; lane++) {
+            mono[frame + lane] = static_cast<float>(laneSin[lane] * amplitude);
+            double nextCos = laneCos[lane] * stepCos - laneSin[lane] * stepSin;
+            laneSin[lane] = laneSin[lane] * stepCos + laneCos[lane] * stepSin;
+            laneCos[lane] = nextCos;
+        }
+    }
+    /* the phase carried to the next block is rotated by the exact angle, so lane rounding never accumulates */
+    double advanceCos = std::cos(step * frames);
+    double advanceSin = std::sin(step * frames);
+    double phaseCos = synth.phaseCos * advanceCos - synth.phaseSin * advanceSin;
+    double phaseSin = synth.phaseSin * advanceCos + synth.phaseCos * advanceSin;
+    double norm = std::sqrt(phaseCos * phaseCos + phaseSin * phaseSin);
+    synth.phaseCos = phaseCos / norm;
+    synth.phaseSin = phaseSin / norm;
+    synth.sweepPosition += frames;
+    if (synth.sweepPosition >= synth.sweepFrames) {
+        synth.sweepPosition = 0;
+        synth.frequency = synth.params.startHz;
+    } else {
+        synth.frequency *= std::pow(synth.sweepRatio, static_cast<double>(frames));
+    }
+}
+
+void SynthImpulse(struct AudioPcmSynth &synth, float *mono, size_t frames)
+{
+    float amplitude = static_cast<float>(synth.params.amplitude);
+    for (size_t frame = 0; frame < frames; frame++) {
+        mono[frame] = (synth.frames + frame) % synth.params.impulsePeriod == 0 ? amplitude : 0.0f;
+    }
+}
+
+void SynthBlock(struct AudioPcmSynth &synth, float *block, size_t frames)
+{
+    size_t count = frames * synth.channelCount;
+    if (synth.params.signal == AUDIO_SYNTH_NOISE) {
+        SynthNoise(synth, block, (count + SYNTH_NOISE_LANES - 1) / SYNTH_NOISE_LANES * SYNTH_NOISE_LANES);
+        return;
+    }
+    float mono[SYNTH_BLOCK_SAMPLES] = {};
+    if (synth.params.signal == AUDIO_SYNTH_SWEEP) {
+        SynthSweep(synth, mono, frames);
+    } else if (synth.params.signal == AUDIO_SYNTH_IMPULSE) {
+        SynthImpulse(synth, mono, frames);
+    }
+    for (size_t frame = 0; frame < frames; frame++) {
+        for (uint32_t channel = 0; channel < synth.channelCount; channel++) {
+            block[frame * synth.channelCount + channel] = mono[frame];
+        }
+    }
+}
+
+#if defined(__SSE2__)
+size_t Encode16BitSimd(const float *block, size_t count, int16_t *out)
+{
+    size_t done = 0;
+    __m128 scale = _mm_set1_ps(FULL_SCALE_16_BIT);
+    for (; done + SIMD_LANES_16_BIT <= count; done += SIMD_LANES_16_BIT) {
+        /* cvtps rounds to nearest and packs saturates, so no explicit clamp is needed */
+        __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(block + done), scale));
+        __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(block + done + 4), scale)); // 4: second half
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + done), _mm_packs_epi32(low, high));
+    }
+    return done;
+}
+#elif defined(__ARM_NEON)
+size_t Encode16BitSimd(const float *block, size_t count, int16_t *out)
+{
+    size_t done = 0;
+    float32x4_t scale = vdupq_n_f32(FULL_SCALE_16_BIT);
+    for (; done + SIMD_LANES_16_BIT <= count; done += SIMD_LANES_16_BIT) {
+        int32x4_t low = vcvtq_s32_f32(vmulq_f32(vld1q_f32(block + done), scale));
+        int32x4_t high = vcvtq_s32_f32(vmulq_f32(vld1q_f32(block + done + 4), scale)); // 4: second half
+        vst1q_s16(out + done, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+    return done;
+}
+#else
+size_t Encode16BitSimd(const float *block, size_t count, int16_t *out)
+{
+    (void)block;
+    (void)count;
+    (void)out;
+    return 0;
+}
+#endif
+
+void EncodeBlock(const float *block, size_t count, uint32_t bits, uint8_t *out)
+{
+    switch (bits) {
+        case PCM_8_BIT:
+            for (size_t index = 0; index < count; index++) {
+                out[index] = static_cast<uint8_t>(UNSIGNED_8_BIT_ZERO +
+                    static_cast<int>(std::lrint(Clamp(block[index]) * FULL_SCALE_8_BIT)));
+            }
+            break;
+        case PCM_16_BIT: {
+            int16_t *samples = reinterpret_cast<int16_t *>(out);
+            for (size_t index = Encode16BitSimd(block, count, samples); index < count; index++) {
+                samples[index] = static_cast<int16_t>(std::lrint(Clamp(block[index]) * FULL_SCALE_16_BIT));
+            }
+            break;
+        }
+        case PCM_24_BIT:
+            /* packed little-endian, three bytes per sample */
+            for (size_t index = 0; index < count; index++) {
+                uint32_t value = static_cast<uint32_t>(std::lrint(Clamp(block[index]) * FULL_SCALE_24_BIT));
+                uint8_t *sample = out + index * PCM_24_BIT / BITS_PER_BYTE;
+                sample[0] = static_cast<uint8_t>(value);
+                sample[1] = static_cast<uint8_t>(value >> BITS_PER_BYTE);
+                sample[2] = static_cast<uint8_t>(value >> (BITS_PER_BYTE * 2)); // 2: third byte of the sample
+            }
+            break;
+        default: {
+            int32_t *samples = reinterpret_cast<int32_t *>(out);
+            for (size_t index = 0; index < count; index++) {
+                samples[index] = static_cast<int32_t>(std::lrint(Clamp(block[index]) * FULL_SCALE_32_BIT));
+            }
+            break;
+        }
+    }
+}
+}
+
+void PcmSynthDefault(struct AudioSynthParams &params, enum AudioSynthSignal signal)
+{
+    params = {};
+    params.signal = signal;
+    params.amplitude = SYNTH_AMPLITUDE;
+    params.startHz = SYNTH_SWEEP_START_HZ;
+    params.endHz = SYNTH_SWEEP_END_HZ;
+    params.sweepSeconds = SYNTH_SWEEP_SECONDS;
+    params.impulsePeriod = SAMPLERATE;
+    params.seed = 1;
+}
+
+int32_t PcmSynthInit(struct AudioPcmSynth &synth, const struct AudioSampleAttributes &attrs,
+    const struct AudioSynthParams &params)
+{
+    synth = {};
+    synth.bits = PcmFormatToBits(attrs.format);
+    synth.channelCount = attrs.channelCount;
+    synth.sampleRate = attrs.sampleRate;
+    if (synth.bits == 0 || synth.bits % BITS_PER_BYTE != 0 || synth.channelCount == 0 ||
+        synth.channelCount > SYNTH_BLOCK_SAMPLES || synth.sampleRate == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    if (params.amplitude < 0 || params.amplitude > 1 ||
+        (params.signal == AUDIO_SYNTH_SWEEP && (params.startHz <= 0 || params.endHz <= 0)) ||
+        (params.signal == AUDIO_SYNTH_IMPULSE && params.impulsePeriod == 0)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    synth.params = params;
+    double highest = synth.sampleRate * NYQUIST_MARGIN;
+    synth.params.startHz = std::fmin(params.startHz, highest);
+    synth.params.endHz = std::fmin(params.endHz, highest);
+    synth.sweepFrames = static_cast<uint64_t>(params.sweepSeconds * synth.sampleRate);
+    synth.sweepFrames = synth.sweepFrames == 0 ? 1 : synth.sweepFrames;
+    synth.sweepRatio = std::pow(synth.params.endHz / synth.params.startHz, 1.0 / synth.sweepFrames);
+    synth.frequency = synth.params.startHz;
+    synth.phaseCos = 1;
+    for (uint32_t lane = 0; lane < SYNTH_NOISE_LANES; lane++) {
+        synth.noise[lane] = (params.seed + lane * NOISE_SEED_STEP) | 1;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+size_t PcmSynthFill(struct AudioPcmSynth &synth, void *data, size_t length)
+{
+    if (data == nullptr || synth.bits == 0 || synth.channelCount == 0) {
+        return 0;
+    }
+    uint8_t *out = static_cast<uint8_t *>(data);
+    size_t frameBytes = synth.bits / BITS_PER_BYTE * synth.channelCount;
+    size_t frames = length / frameBytes;
+    size_t blockFrames = SYNTH_BLOCK_SAMPLES / synth.channelCount;
+    float block[SYNTH_BLOCK_SAMPLES];
+    for (size_t done = 0; done < frames;) {
+        size_t count = frames - done < blockFrames ? frames - done : blockFrames;
+        SynthBlock(synth, block, count);
+        EncodeBlock(block, count * synth.channelCount, synth.bits, out + done * frameBytes);
+        synth.frames += count;
+        done += count;
+    }
+    return frames * frameBytes;
+}
+}
+}
@@ -0,0 +1,463 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_pcm_verify.h
+ *
+ * @brief Implements the streaming PCM content verifier run on captured buffers.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "audio_hdi_common.h"
+#include "audio_hdi_pcm_verify.h"
+
+namespace HMOS {
+namespace Audio {
+namespace {
+const double FULL_SCALE_8_BIT = 128.0;
+const double FULL_SCALE_16_BIT = 32768.0;
+const double FULL_SCALE_24_BIT = 8388608.0;
+const double FULL_SCALE_32_BIT = 2147483648.0;
+const uint32_t BITS_PER_BYTE = 8;
+const int UNSIGNED_8_BIT_ZERO = 128;
+const int DECODE_CHUNK = 64;
+const int SIMD_LANES_16_BIT = 8;
+/* int32 lane sums of 16-bit samples stay exact for this many samples before they are folded into int64 */
+const size_t SIMD_BLOCK_16_BIT = 1024;
+const double PI = 3.14159265358979323846;
+const double HALF = 0.5;
+
+inline void ZeroRunStep(struct AudioPcmVerifier &verifier, bool zero)
+{
+    if (zero) {
+        verifier.zeroRun++;
+        return;
+    }
+    verifier.longestZeroRun = verifier.zeroRun > verifier.longestZeroRun ? verifier.zeroRun : verifier.longestZeroRun;
+    verifier.zeroRun = 0;
+}
+
+/* a block of lanes is either all zero, all non-zero, or needs a per-sample walk */
+void ZeroRunMask(struct AudioPcmVerifier &verifier, const int16_t *samples, uint32_t zeroMask, uint32_t fullMask)
+{
+    if (zeroMask == fullMask) {
+        verifier.zeroRun += SIMD_LANES_16_BIT;
+        return;
+    }
+    if (zeroMask == 0) {
+        ZeroRunStep(verifier, false);
+        return;
+    }
+    for (int lane = 0; lane < SIMD_LANES_16_BIT; lane++) {
+        ZeroRunStep(verifier, samples[lane] == 0);
+    }
+}
+
+#if defined(__SSE2__)
+size_t Feed16BitSimd(struct AudioPcmVerifier &verifier, const int16_t *samples, size_t count)
+{
+    const uint32_t fullMask = 0xFFFF;
+    size_t done = 0;
+    __m128i maxValue = _mm_set1_epi16(INT16_MIN);
+    __m128i minValue = _mm_set1_epi16(INT16_MAX);
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i zero = _mm_setzero_si128();
+    __m128i squareSum = _mm_setzero_si128();
+    while (count - done >= SIMD_LANES_16_BIT) {
+        size_t blockEnd = done + SIMD_BLOCK_16_BIT;
+        blockEnd = blockEnd > count ? count : blockEnd;
+        __m128i blockSum = _mm_setzero_si128();
+        for (; done + SIMD_LANES_16_BIT <= blockEnd; done += SIMD_LANES_16_BIT) {
+            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples + done));
+            blockSum = _mm_add_epi32(blockSum, _mm_madd_epi16(value, ones));
+            /* each pair of squares fits in an unsigned 32-bit lane, widen before accumulating */
+            __m128i square = _mm_madd_epi16(value, value);
+            squareSum = _mm_add_epi64(squareSum, _mm_unpacklo_epi32(square, zero));
+            squareSum = _mm_add_epi64(squareSum, _mm_unpackhi_epi32(square, zero));
+            maxValue = _mm_max_epi16(maxValue, value);
+            minValue = _mm_min_epi16(minValue, value);
+            uint32_t zeroMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi16(value, zero)));
+            ZeroRunMask(verifier, samples + done, zeroMask, fullMask);
+        }
+        int32_t lanes[4]; // 4: int32 lanes in a 128-bit register
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), blockSum);
+        verifier.integerSum += static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+    uint64_t squares[2]; // 2: int64 lanes in a 128-bit register
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(squares), squareSum);
+    verifier.integerSumSquare += squares[0] + squares[1];
+    int16_t maxLanes[SIMD_LANES_16_BIT];
+    int16_t minLanes[SIMD_LANES_16_BIT];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxLanes), maxValue);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(minLanes), minValue);
+    for (int lane = 0; lane < SIMD_LANES_16_BIT && done > 0; lane++) {
+        double peak = std::fmax(maxLanes[lane], -static_cast<double>(minLanes[lane])) / FULL_SCALE_16_BIT;
+        verifier.peak = peak > verifier.peak ? peak : verifier.peak;
+    }
+    return done;
+}
+#elif defined(__ARM_NEON)
+size_t Feed16BitSimd(struct AudioPcmVerifier &verifier, const int16_t *samples, size_t count)
+{
+    const uint32_t fullMask = 0xFF;
+    size_t done = 0;
+    int16x8_t maxValue = vdupq_n_s16(INT16_MIN);
+    int16x8_t minValue = vdupq_n_s16(INT16_MAX);
+    int64x2_t squareSum = vdupq_n_s64(0);
+    while (count - done >= SIMD_LANES_16_BIT) {
+        size_t blockEnd = done + SIMD_BLOCK_16_BIT;
+        blockEnd = blockEnd > count ? count : blockEnd;
+        int32x4_t blockSum = vdupq_n_s32(0);
+        for (; done + SIMD_LANES_16_BIT <= blockEnd; done += SIMD_LANES_16_BIT) {
+            int16x8_t value = vld1q_s16(samples + done);
+            blockSum = vpadalq_s16(blockSum, value);
+            squareSum = vpadalq_s32(squareSum, vmull_s16(vget_low_s16(value), vget_low_s16(value)));
+            squareSum = vpadalq_s32(squareSum, vmull_s16(vget_high_s16(value), vget_high_s16(value)));
+            maxValue = vmaxq_s16(maxValue, value);
+            minValue = vminq_s16(minValue, value);
+            /* narrow the per-lane compare to one byte per lane and read it back as a bit mask */
+            uint8x8_t zeroLanes = vmovn_u16(vceqq_s16(value, vdupq_n_s16(0)));
+            uint8_t zeroBytes[SIMD_LANES_16_BIT];
+            vst1_u8(zeroBytes, zeroLanes);
+            uint32_t zeroMask = 0;
+            for (int lane = 0; lane < SIMD_LANES_16_BIT; lane++) {
+                zeroMask |= static_cast<uint32_t>(zeroBytes[lane] & 1) << lane;
+            }
+            ZeroRunMask(verifier, samples + done, zeroMask, fullMask);
+        }
+        int64x2_t blockWide = vpaddlq_s32(blockSum);
+        verifier.integerSum += vgetq_lane_s64(blockWide, 0) + vgetq_lane_s64(blockWide, 1);
+    }
+    verifier.integerSumSquare += static_cast<uint64_t>(vgetq_lane_s64(squareSum, 0) + vgetq_lane_s64(squareSum, 1));
+    int16_t maxLanes[SIMD_LANES_16_BIT];
+    int16_t minLanes[SIMD_LANES_16_BIT];
+    vst1q_s16(maxLanes, maxValue);
+    vst1q_s16(minLanes, minValue);
+    for (int lane = 0; lane < SIMD_LANES_16_BIT && done > 0; lane++) {
+        double peak = std::fmax(maxLanes[lane], -static_cast<double>(minLanes[lane])) / FULL_SCALE_16_BIT;
+        verifier.peak = peak > verifier.peak ? peak : verifier.peak;
+    }
+    return done;
+}
+#else
+size_t Feed16BitSimd(struct AudioPcmVerifier &verifier, const int16_t *samples, size_t count)
+{
+    (void)verifier;
+    (void)samples;
+    (void)count;
+    return 0;
+}
+#endif
+
+void Feed16Bit(struct AudioPcmVerifier &verifier, const uint8_t *data, size_t count)
+{
+    const int16_t *samples = reinterpret_cast<const int16_t *>(data);
+    size_t done = Feed16BitSimd(verifier, samples, count);
+    for (; done < count; done++) {
+        int32_t value = samples[done];
+        verifier.integerSum += value;
+        verifier.integerSumSquare += static_cast<uint64_t>(value * value);
+        double peak = std::fabs(value / FULL_SCALE_16_BIT);
+        verifier.peak = peak > verifier.peak ? peak : verifier.peak;
+        ZeroRunStep(verifier, value == 0);
+    }
+}
+
+inline float DecodeSample(const uint8_t *data, uint32_t bits)
+{
+    switch (bits) {
+        case PCM_8_BIT:
+            return static_cast<float>((data[0] - UNSIGNED_8_BIT_ZERO) / FULL_SCALE_8_BIT);
+        case PCM_16_BIT:
+            return static_cast<float>(*reinterpret_cast<const int16_t *>(data) / FULL_SCALE_16_BIT);
+        case PCM_24_BIT: {
+            /* packed little-endian, sign extended through the top byte */
+            uint32_t packed = static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << BITS_PER_BYTE |
+                static_cast<uint32_t>(data[2]) << (BITS_PER_BYTE * 2); // 2: third byte of the sample
+            int32_t value = static_cast<int32_t>(packed << BITS_PER_BYTE) >> BITS_PER_BYTE;
+            return static_cast<float>(value / FULL_SCALE_24_BIT);
+        }
+        default:
+            return static_cast<float>(*reinterpret_cast<const int32_t *>(data) / FULL_SCALE_32_BIT);
+    }
+}
+
+/* the remaining widths are decoded to float in small chunks so the reduction loop stays branch free */
+void FeedDecoded(struct AudioPcmVerifier &verifier, const uint8_t *data, size_t count)
+{
+    uint32_t sampleBytes = verifier.bits / BITS_PER_BYTE;
+    float chunk[DECODE_CHUNK];
+    for (size_t done = 0; done < count;) {
+        int length = count - done < DECODE_CHUNK ? static_cast<int>(count - done) : DECODE_CHUNK;
+        for (int index = 0; index < length; index++) {
+            chunk[index] = DecodeSample(data + (done + index) * sampleBytes, verifier.bits);
+        }
+        float sum = 0;
+        float sumSquare = 0;
+        float peak = 0;
+        for (int index = 0; index < length; index++) {
+            sum += chunk[index];
+            sumSquare += chunk[index] * chunk[index];
+            peak = std::fabs(chunk[index]) > peak ? std::fabs(chunk[index]) : peak;
+        }
+        for (int index = 0; index < length; index++) {
+            ZeroRunStep(verifier, chunk[index] == 0);
+        }
+        verifier.sum += sum;
+        verifier.sumSquare += sumSquare;
+        verifier.peak = peak > verifier.peak ? peak : verifier.peak;
+        done += static_cast<size_t>(length);
+    }
+}
+
+#if defined(__SSE2__)
+int32_t PeakAbs16Simd(const int16_t *samples, size_t count, size_t &done)
+{
+    __m128i peak = _mm_setzero_si128();
+    __m128i zero = _mm_setzero_si128();
+    for (done = 0; done + SIMD_LANES_16_BIT <= count; done += SIMD_LANES_16_BIT) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(samples + done));
+        /* saturating negate keeps -32768 at 32767 instead of wrapping */
+        peak = _mm_max_epi16(peak, _mm_max_epi16(value, _mm_subs_epi16(zero, value)));
+    }
+    int16_t lanes[SIMD_LANES_16_BIT];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), peak);
+    return *std::max_element(lanes, lanes + SIMD_LANES_16_BIT);
+}
+#elif defined(__ARM_NEON)
+int32_t PeakAbs16Simd(const int16_t *samples, size_t count, size_t &done)
+{
+    int16x8_t peak = vdupq_n_s16(0);
+    for (done = 0; done + SIMD_LANES_16_BIT <= count; done += SIMD_LANES_16_BIT) {
+        peak = vmaxq_s16(peak, vqabsq_s16(vld1q_s16(samples + done)));
+    }
+    int16_t lanes[SIMD_LANES_16_BIT];
+    vst1q_s16(lanes, peak);
+    return *std::max_element(lanes, lanes + SIMD_LANES_16_BIT);
+}
+#else
+int32_t PeakAbs16Simd(const int16_t *samples, size_t count, size_t &done)
+{
+    (void)samples;
+    (void)count;
+    done = 0;
+    return 0;
+}
+#endif
+
+double BlockPeak(uint32_t bits, const uint8_t *data, size_t count)
+{
+    if (bits == PCM_16_BIT) {
+        const int16_t *samples = reinterpret_cast<const int16_t *>(data);
+        size_t done = 0;
+        int32_t peak = PeakAbs16Simd(samples, count, done);
+        for (; done < count; done++) {
+            peak = std::max(peak, std::abs(static_cast<int32_t>(samples[done])));
+        }
+        return peak / FULL_SCALE_16_BIT;
+    }
+    double peak = 0;
+    uint32_t sampleBytes = bits / BITS_PER_BYTE;
+    for (size_t index = 0; index < count; index++) {
+        peak = std::fmax(peak, std::fabs(DecodeSample(data + index * sampleBytes, bits)));
+    }
+    return peak;
+}
+
+void EnvelopeCloseBlock(struct AudioPcmEnvelope &envelope)
+{
+    struct AudioEnvelopeStats &stats = envelope.stats;
+    if (stats.blocks == 0) {
+        stats.minLevel = envelope.blockPeak;
+        stats.maxLevel = envelope.blockPeak;
+    } else {
+        double step = std::fabs(envelope.blockPeak - envelope.lastPeak);
+        stats.maxStep = std::fmax(stats.maxStep, step);
+        stats.zipperSteps += step > envelope.stepLimit ? 1 : 0;
+        stats.minLevel = std::fmin(stats.minLevel, envelope.blockPeak);
+        stats.maxLevel = std::fmax(stats.maxLevel, envelope.blockPeak);
+    }
+    stats.blocks++;
+    envelope.lastPeak = envelope.blockPeak;
+    envelope.blockPeak = 0;
+    envelope.blockFill = 0;
+}
+
+/* quadrature correlation against the reference tone, driven by a recursive oscillator */
+void FeedTone(struct AudioPcmVerifier &verifier, const uint8_t *data, size_t frames)
+{
+    uint32_t sampleBytes = verifier.bits / BITS_PER_BYTE;
+    for (size_t frame = 0; frame < frames; frame++) {
+        double mix = 0;
+        for (uint32_t channel = 0; channel < verifier.channelCount; channel++) {
+            mix += DecodeSample(data + (frame * verifier.channelCount + channel) * sampleBytes, verifier.bits);
+        }
+        mix /= verifier.channelCount;
+        verifier.toneInPhase += mix * verifier.toneSin;
+        verifier.toneQuadrature += mix * verifier.toneCos;
+        verifier.mixSum += mix;
+        verifier.mixSumSquare += mix * mix;
+        double toneCos = verifier.toneCos * verifier.stepCos - verifier.toneSin * verifier.stepSin;
+        verifier.toneSin = verifier.toneSin * verifier.stepCos + verifier.toneCos * verifier.stepSin;
+        verifier.toneCos = toneCos;
+    }
+    double norm = std::sqrt(verifier.toneCos * verifier.toneCos + verifier.toneSin * verifier.toneSin);
+    if (norm > 0) {
+        verifier.toneCos /= norm;
+        verifier.toneSin /= norm;
+    }
+    verifier.frames += frames;
+}
+}
+
+int32_t PcmVerifyInit(struct AudioPcmVerifier &verifier, const struct AudioSampleAttributes &attrs,
+    double referenceHz)
+{
+    verifier = {};
+    verifier.bits = PcmFormatToBits(attrs.format);
+    verifier.channelCount = attrs.channelCount;
+    if (verifier.channelCount == 0 || verifier.bits % BITS_PER_BYTE != 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    verifier.toneCos = 1;
+    if (referenceHz > 0 && attrs.sampleRate > 0) {
+        double step = 2 * PI * referenceHz / attrs.sampleRate; // 2: a full turn of the oscillator
+        verifier.stepCos = std::cos(step);
+        verifier.stepSin = std::sin(step);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+void PcmVerifyFeed(struct AudioPcmVerifier &verifier, const void *data, size_t length)
+{
+    if (data == nullptr || verifier.bits == 0 || verifier.channelCount == 0) {
+        return;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    size_t count = length / (verifier.bits / BITS_PER_BYTE);
+    if (verifier.bits == PCM_16_BIT) {
+        Feed16Bit(verifier, bytes, count);
+    } else {
+        FeedDecoded(verifier, bytes, count);
+    }
+    verifier.samples += count;
+    if (verifier.stepCos != 0 || verifier.stepSin != 0) {
+        FeedTone(verifier, bytes, count / verifier.channelCount);
+    }
+}
+
+void PcmVerifyResult(const struct AudioPcmVerifier &verifier, struct AudioPcmStats &stats)
+{
+    stats = {};
+    stats.samples = verifier.samples;
+    stats.peak = verifier.peak;
+    stats.longestZeroRun = verifier.zeroRun > verifier.longestZeroRun ? verifier.zeroRun : verifier.longestZeroRun;
+    if (verifier.samples == 0) {
+        return;
+    }
+    double sum = verifier.sum + verifier.integerSum / FULL_SCALE_16_BIT;
+    double sumSquare = verifier.sumSquare + verifier.integerSumSquare / (FULL_SCALE_16_BIT * FULL_SCALE_16_BIT);
+    stats.dcOffset = sum / verifier.samples;
+    stats.rms = std::sqrt(sumSquare / verifier.samples);
+    /* the tone has no DC term, so correlate against the AC energy of the mix only */
+    double mixEnergy = verifier.frames == 0 ? 0 :
+        verifier.mixSumSquare - verifier.mixSum * verifier.mixSum / verifier.frames;
+    if (mixEnergy > 0) {
+        double magnitude = std::sqrt(verifier.toneInPhase * verifier.toneInPhase +
+            verifier.toneQuadrature * verifier.toneQuadrature);
+        stats.correlation = magnitude / std::sqrt(mixEnergy * verifier.frames * HALF);
+        stats.correlation = stats.correlation > 1 ? 1 : stats.correlation;
+    }
+}
+
+int32_t PcmVerifyCheck(const struct AudioPcmStats &stats, const struct AudioPcmVerifyLimits &limits)
+{
+    if (stats.samples == 0 || stats.rms < limits.minRms || std::fabs(stats.dcOffset) > limits.maxDcOffset ||
+        stats.longestZeroRun > limits.maxZeroRun || stats.correlation < limits.minCorrelation) {
+        return HDF_FAILURE;
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+void PcmStatsPrint(const char *label, const struct AudioPcmStats &stats)
+{
+    printf("%s: samples=%llu rms=%.4f peak=%.4f dc=%.4f zeroRun=%llu correlation=%.4f\n", label,
+        static_cast<unsigned long long>(stats.samples), stats.rms, stats.peak, stats.dcOffset,
+        static_cast<unsigned long long>(stats.longestZeroRun), stats.correlation);
+}
+
+int32_t PcmEnvelopeInit(struct AudioPcmEnvelope &envelope, const struct AudioSampleAttributes &attrs,
+    uint32_t blockFrames, double stepLimit)
+{
+    envelope = {};
+    envelope.bits = PcmFormatToBits(attrs.format);
+    if (blockFrames == 0) {
+        blockFrames = attrs.sampleRate / ENVELOPE_BLOCKS_PER_SECOND;
+    }
+    if (attrs.channelCount == 0 || blockFrames == 0 || envelope.bits == 0 || envelope.bits % BITS_PER_BYTE != 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    envelope.blockSamples = blockFrames * attrs.channelCount;
+    envelope.stepLimit = stepLimit;
+    return AUDIO_HAL_SUCCESS;
+}
+
+void PcmEnvelopeFeed(struct AudioPcmEnvelope &envelope, const void *data, size_t length)
+{
+    if (data == nullptr || envelope.blockSamples == 0) {
+        return;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint32_t sampleBytes = envelope.bits / BITS_PER_BYTE;
+    size_t count = length / sampleBytes;
+    for (size_t done = 0; done < count;) {
+        size_t take = std::min<size_t>(count - done, envelope.blockSamples - envelope.blockFill);
+        envelope.blockPeak = std::fmax(envelope.blockPeak, BlockPeak(envelope.bits, bytes + done * sampleBytes, take));
+        envelope.blockFill += take;
+        done += take;
+        if (envelope.blockFill == envelope.blockSamples) {
+            EnvelopeCloseBlock(envelope);
+        }
+    }
+}
+
+void PcmEnvelopeResult(const struct AudioPcmEnvelope &envelope, struct AudioEnvelopeStats &stats)
+{
+    stats = envelope.stats;
+}
+}
+}
@@ -0,0 +1,1405 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_perf.h
+ *
+ * @brief Implements the latency histogram and timed frame loops used by the audio benchmark suites.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include "audio_hdi_perf.h"
+
+namespace HMOS {
+namespace Audio {
+namespace {
+const int64_t LATENCY_MAX_VALUE = (1LL << (LATENCY_MAX_MAGNITUDE + 1)) - 1;
+const double PERCENT = 100.0;
+const int STRESS_LABEL_LENGTH = 128;
+const double PPM = 1000000.0;
+const double NSEC_PER_HOUR = 3600.0 * SECTONSEC;
+const uint64_t BYTES_PER_KB = 1024;
+const uint64_t MSEC_PER_SEC = 1000;
+
+int LatencyBucketIndex(int64_t valueNs)
+{
+    if (valueNs < LATENCY_SUB_BUCKET_COUNT) {
+        return static_cast<int>(valueNs);
+    }
+    int msb = 63 - __builtin_clzll(static_cast<uint64_t>(valueNs)); // 63: index of the top bit in a 64-bit word
+    int shift = msb - LATENCY_SUB_BUCKET_BITS;
+    int subBucket = static_cast<int>(valueNs >> shift) - LATENCY_SUB_BUCKET_COUNT;
+    return LATENCY_SUB_BUCKET_COUNT + shift * LATENCY_SUB_BUCKET_COUNT + subBucket;
+}
+
+int64_t LatencyBucketValue(int index)
+{
+    if (index < LATENCY_SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = (index - LATENCY_SUB_BUCKET_COUNT) / LATENCY_SUB_BUCKET_COUNT;
+    int64_t subBucket = (index - LATENCY_SUB_BUCKET_COUNT) % LATENCY_SUB_BUCKET_COUNT + LATENCY_SUB_BUCKET_COUNT;
+    int64_t low = subBucket << shift;
+    int64_t high = ((subBucket + 1) << shift) - 1;
+    return low + (high - low) / 2; // 2: report the middle of the bucket
+}
+
+void UpdateDelayTime(struct PrepareAudioPara &audiopara, int64_t startNs, int64_t endNs, int64_t totalNs,
+    int64_t lastNs, uint32_t frameCount)
+{
+    audiopara.start.tv_sec = startNs / SECTONSEC;
+    audiopara.start.tv_usec = (startNs % SECTONSEC) / NSEC_PER_USEC;
+    audiopara.end.tv_sec = endNs / SECTONSEC;
+    audiopara.end.tv_usec = (endNs % SECTONSEC) / NSEC_PER_USEC;
+    audiopara.delayTime = lastNs / NSEC_PER_USEC;
+    audiopara.totalTime = totalNs / NSEC_PER_USEC;
+    audiopara.averageDelayTime = static_cast<float>(audiopara.totalTime) / frameCount;
+}
+
+/* holds every stream at the gate until all of them have created and started their handles */
+struct StressGate {
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint32_t pending = 0;
+    int64_t deadlineNs = 0;
+    int64_t durationNs = 0;
+};
+
+void StressGateArrive(struct StressGate &gate)
+{
+    std::unique_lock<std::mutex> lock(gate.mutex);
+    if (--gate.pending == 0) {
+        gate.deadlineNs = GetMonotonicNs() + gate.durationNs;
+        gate.cond.notify_all();
+        return;
+    }
+    gate.cond.wait(lock, [&gate] { return gate.pending == 0; });
+}
+
+int64_t PcmBytesToNs(uint64_t bytes, const struct AudioSampleAttributes &attrs)
+{
+    uint64_t bytesPerSecond = static_cast<uint64_t>(attrs.sampleRate) * attrs.channelCount *
+        (PcmFormatToBits(attrs.format) >> MOVE_RIGHT_NUM);
+    return bytesPerSecond == 0 ? 0 : static_cast<int64_t>(bytes * SECTONSEC / bytesPerSecond);
+}
+
+/* wall clock against the audio carried so far; a stream more than one buffer behind has starved or overrun */
+struct StressClock {
+    int64_t startNs;
+    int64_t audioNs;
+};
+
+void StressRecordCall(struct AudioStressStream &stream, struct StressClock &clock, int64_t callNs,
+    uint64_t replyBytes, const struct AudioSampleAttributes &attrs)
+{
+    LatencyHistogramRecord(stream.histogram, callNs);
+    stream.bytes += replyBytes;
+    stream.frames++;
+    int64_t bufferNs = PcmBytesToNs(replyBytes, attrs);
+    clock.audioNs += bufferNs;
+    int64_t behindNs = GetMonotonicNs() - clock.startNs - clock.audioNs;
+    if (behindNs > bufferNs) {
+        stream.xruns++;
+        clock.audioNs += behindNs;
+    }
+}
+
+/*
+ * matches completions to submits in order; returns the number of events consumed. Events stamped before sinceNs
+ * were signalled for an earlier run on the same queue and are discarded
+ */
+uint32_t NonblockDrain(struct AudioRenderEventQueue &queue, std::deque<int64_t> &pending,
+    struct AudioNonblockStats &stats, int64_t sinceNs)
+{
+    struct AudioRenderEvent event = {};
+    uint32_t consumed = 0;
+    while (RenderEventQueuePop(queue, event)) {
+        consumed++;
+        if (event.timestampNs < sinceNs) {
+            continue;
+        }
+        if (event.type == AUDIO_RENDER_FULL) {
+            stats.renderFull++;
+        } else if (event.type == AUDIO_NONBLOCK_WRITE_COMPELETED && !pending.empty()) {
+            LatencyHistogramRecord(stats.histogram, event.timestampNs - pending.front());
+            pending.pop_front();
+            stats.completed++;
+        }
+    }
+    return consumed;
+}
+
+/* waits until the outstanding window drops below limit; false once a wait times out */
+bool NonblockWait(struct AudioRenderEventQueue &queue, std::deque<int64_t> &pending,
+    struct AudioNonblockStats &stats, size_t limit, int64_t sinceNs)
+{
+    int64_t deadlineNs = GetMonotonicNs() + NONBLOCK_EVENT_TIMEOUT_NS;
+    while (pending.size() > limit) {
+        if (NonblockDrain(queue, pending, stats, sinceNs) > 0) {
+            deadlineNs = GetMonotonicNs() + NONBLOCK_EVENT_TIMEOUT_NS;
+            continue;
+        }
+        if (!RenderEventQueueWait(queue, deadlineNs)) {
+            stats.timeouts++;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * a HAL callback may still be running on a queue after RegCallback has swapped it out, and only DestroyRender
+ * ends that; every render handle keeps its queue for the life of the process, reused by the next call on it.
+ * A reused queue is never reset under a late push: the consumer only drains it by moving tail up to head
+ */
+struct AudioRenderEventQueue &RenderEventQueueFor(struct AudioRender *render)
+{
+    static std::mutex mutex;
+    static std::map<struct AudioRender *, std::unique_ptr<struct AudioRenderEventQueue>> queues;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<struct AudioRenderEventQueue> &queue = queues[render];
+    if (queue == nullptr) {
+        queue = std::make_unique<struct AudioRenderEventQueue>();
+        RenderEventQueueInit(*queue);
+    } else {
+        queue->tail.store(queue->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    return *queue;
+}
+
+void AttrSweepInitCase(struct AudioAttrSweepCase &sweepCase, struct AudioSampleAttributes &attrs)
+{
+    InitAttrsUpdate(attrs, sweepCase.format, sweepCase.channelCount, sweepCase.sampleRate);
+    attrs.period = sweepCase.period;
+    attrs.frameSize = (PcmFormatToBits(sweepCase.format) >> MOVE_RIGHT_NUM) * sweepCase.channelCount;
+    attrs.startThreshold = attrs.frameSize == 0 ? 0 : attrs.period / attrs.frameSize;
+    sweepCase.result = AUDIO_HAL_SUCCESS;
+    sweepCase.matched = false;
+    sweepCase.setGetNs = 0;
+    sweepCase.firstFrameNs = -1;
+}
+
+void AttrSweepMatch(struct AudioAttrSweepCase &sweepCase, const struct AudioSampleAttributes &attrsValue)
+{
+    sweepCase.matched = attrsValue.format == sweepCase.format && attrsValue.sampleRate == sweepCase.sampleRate &&
+        attrsValue.channelCount == sweepCase.channelCount;
+}
+
+void AttrSweepRenderCase(struct PrepareAudioPara &audiopara, struct AudioAttrSweepCase &sweepCase)
+{
+    struct AudioRender *render = audiopara.render;
+    struct AudioSampleAttributes attrsValue = {};
+    uint64_t replyBytes = 0;
+    AttrSweepInitCase(sweepCase, audiopara.attrs);
+    int64_t beginNs = GetMonotonicNs();
+    sweepCase.result = AudioRenderSetGetSampleAttributes(audiopara.attrs, attrsValue, render);
+    sweepCase.setGetNs = GetMonotonicNs() - beginNs;
+    if (sweepCase.result < 0) {
+        return;
+    }
+    AttrSweepMatch(sweepCase, attrsValue);
+    uint32_t bufferSize = PcmFramesToBytes(audiopara.attrs);
+    if (bufferSize == 0) {
+        return;
+    }
+    std::vector<char> frame(bufferSize, 0);
+    beginNs = GetMonotonicNs();
+    sweepCase.result = render->control.Start((AudioHandle)render);
+    if (sweepCase.result < 0) {
+        return;
+    }
+    sweepCase.result = render->RenderFrame(render, frame.data(), bufferSize, &replyBytes);
+    if (sweepCase.result >= 0) {
+        sweepCase.firstFrameNs = GetMonotonicNs() - beginNs;
+    }
+    (void)render->control.Stop((AudioHandle)render);
+}
+
+void AttrSweepCaptureCase(struct PrepareAudioPara &audiopara, struct AudioAttrSweepCase &sweepCase)
+{
+    struct AudioCapture *capture = audiopara.capture;
+    struct AudioSampleAttributes attrsValue = {};
+    uint64_t replyBytes = 0;
+    AttrSweepInitCase(sweepCase, audiopara.attrs);
+    int64_t beginNs = GetMonotonicNs();
+    sweepCase.result = AudioCaptureSetGetSampleAttributes(audiopara.attrs, attrsValue, capture);
+    sweepCase.setGetNs = GetMonotonicNs() - beginNs;
+    if (sweepCase.result < 0) {
+        return;
+    }
+    AttrSweepMatch(sweepCase, attrsValue);
+    uint32_t bufferSize = FRAME_COUNT * PcmFramesToBytes(audiopara.attrs);
+    if (bufferSize == 0) {
+        return;
+    }
+    std::vector<char> frame(bufferSize, 0);
+    beginNs = GetMonotonicNs();
+    sweepCase.result = capture->control.Start((AudioHandle)capture);
+    if (sweepCase.result < 0) {
+        return;
+    }
+    /* -1 is the transient "no data yet" right after Start, as in StartRecord */
+    for (int32_t tryNumFrame = 0; tryNumFrame <= TRY_NUM_FRAME; tryNumFrame++) {
+        sweepCase.result = capture->CaptureFrame(capture, frame.data(), bufferSize, &replyBytes);
+        if (sweepCase.result != -1) {
+            break;
+        }
+    }
+    if (sweepCase.result >= 0) {
+        sweepCase.firstFrameNs = GetMonotonicNs() - beginNs;
+    }
+    (void)capture->control.Stop((AudioHandle)capture);
+}
+
+int32_t AttrSweepRun(struct PrepareAudioPara &audiopara, const struct AudioAttrSweep &sweep,
+    std::vector<struct AudioAttrSweepCase> &cases,
+    void (*runCase)(struct PrepareAudioPara &audiopara, struct AudioAttrSweepCase &sweepCase))
+{
+    if (sweep.formats == nullptr || sweep.channels == nullptr || sweep.sampleRates == nullptr ||
+        sweep.periods == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    cases.clear();
+    cases.reserve(sweep.formatCount * sweep.channelCount * sweep.sampleRateCount * sweep.periodCount);
+    /* one unrecorded pass at the default attributes so the first case does not pay for the cold path */
+    struct AudioAttrSweepCase warmUp = { AUDIO_FORMAT_PCM_16_BIT, CHANNELCOUNT, SAMPLERATE,
+        DEEP_BUFFER_RENDER_PERIOD_SIZE, AUDIO_HAL_SUCCESS, false, 0, -1 };
+    runCase(audiopara, warmUp);
+    for (uint32_t formatIndex = 0; formatIndex < sweep.formatCount; formatIndex++) {
+        for (uint32_t channelIndex = 0; channelIndex < sweep.channelCount; channelIndex++) {
+            for (uint32_t rateIndex = 0; rateIndex < sweep.sampleRateCount; rateIndex++) {
+                for (uint32_t periodIndex = 0; periodIndex < sweep.periodCount; periodIndex++) {
+                    struct AudioAttrSweepCase sweepCase = { sweep.formats[formatIndex],
+                        sweep.channels[channelIndex], sweep.sampleRates[rateIndex], sweep.periods[periodIndex],
+                        AUDIO_HAL_SUCCESS, false, 0, -1 };
+                    runCase(audiopara, sweepCase);
+                    cases.push_back(sweepCase);
+                }
+            }
+        }
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+struct PositionSample {
+    int64_t stampNs;
+    int64_t hostNs;
+    uint64_t frames;
+};
+
+struct SoakStream {
+    std::atomic<uint64_t> bytes{0};
+    uint32_t cycles = 0;
+    int32_t result = AUDIO_HAL_SUCCESS;
+};
+
+uint64_t ReadRssKb()
+{
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return 0;
+    }
+    int fields = fscanf(statm, "%llu %llu", &size, &resident);
+    (void)fclose(statm);
+    if (fields != 2) { // 2: size and resident
+        return 0;
+    }
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) / BYTES_PER_KB;
+}
+
+uint32_t CountOpenFds()
+{
+    uint32_t count = 0;
+    DIR *dir = opendir("/proc/self/fd");
+    if (dir == nullptr) {
+        return 0;
+    }
+    for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        count += entry->d_name[0] == '.' ? 0 : 1;
+    }
+    (void)closedir(dir);
+    return count > 0 ? count - 1 : 0; /* the directory stream's own descriptor */
+}
+
+void SoakTakeSample(TestAudioManager *manager, int64_t startNs, const struct SoakStream &render,
+    const struct SoakStream &capture, struct AudioSoakReport &report)
+{
+    struct AudioSoakSample sample = {};
+    sample.elapsedNs = GetMonotonicNs() - startNs;
+    sample.rssKb = ReadRssKb();
+    sample.fds = CountOpenFds();
+    AdapterCacheCounts(manager, sample.adapters, sample.adapterReferences);
+    sample.renderBytes = render.bytes.load(std::memory_order_relaxed);
+    sample.captureBytes = capture.bytes.load(std::memory_order_relaxed);
+    report.samples.push_back(sample);
+}
+
+/* every cycle creates, streams and destroys a render so per-handle leaks accumulate as well as per-frame ones */
+void SoakRender(TestAudioManager *manager, struct SoakStream &stream, int64_t deadlineNs)
+{
+    struct AudioSampleAttributes attrs = {};
+    const struct AudioPcmFixture *fixture = nullptr;
+    uint64_t replyBytes = 0;
+    InitAttrs(attrs);
+    if (GetPcmFixture(AUDIO_FILE, attrs, fixture) != HDF_SUCCESS) {
+        stream.result = HDF_FAILURE;
+        return;
+    }
+    while (stream.result == AUDIO_HAL_SUCCESS && GetMonotonicNs() < deadlineNs) {
+        struct AudioAdapter *adapter = nullptr;
+        struct AudioRender *render = nullptr;
+        stream.result = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+        if (stream.result < 0) {
+            break;
+        }
+        int32_t ret = render->control.Start((AudioHandle)render);
+        int64_t cycleEndNs = std::min(deadlineNs, GetMonotonicNs() + SOAK_CYCLE_MS * NSEC_PER_MSEC);
+        while (ret >= 0 && GetMonotonicNs() < cycleEndNs) {
+            ret = render->RenderFrame(render, fixture->frame, fixture->frameSize, &replyBytes);
+            stream.bytes.fetch_add(ret < 0 ? 0 : replyBytes, std::memory_order_relaxed);
+        }
+        (void)render->control.Stop((AudioHandle)render);
+        adapter->DestroyRender(adapter, render);
+        ReleaseLoadAdapter(manager, adapter);
+        stream.result = ret < 0 ? ret : AUDIO_HAL_SUCCESS;
+        stream.cycles++;
+    }
+}
+
+void SoakCapture(TestAudioManager *manager, struct SoakStream &stream, int64_t deadlineNs)
+{
+    uint64_t replyBytes = 0;
+    std::vector<char> frame(BUFFER_LENTH, 0);
+    while (stream.result == AUDIO_HAL_SUCCESS && GetMonotonicNs() < deadlineNs) {
+        struct AudioAdapter *adapter = nullptr;
+        struct AudioCapture *capture = nullptr;
+        int32_t tryNumFrame = 0;
+        stream.result = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+        if (stream.result < 0) {
+            break;
+        }
+        int32_t ret = capture->control.Start((AudioHandle)capture);
+        int64_t cycleEndNs = std::min(deadlineNs, GetMonotonicNs() + SOAK_CYCLE_MS * NSEC_PER_MSEC);
+        while (ret >= 0 && GetMonotonicNs() < cycleEndNs) {
+            ret = capture->CaptureFrame(capture, frame.data(), frame.size(), &replyBytes);
+            /* -1 is the transient "no data yet" of StartRecord */
+            if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+                ret = AUDIO_HAL_SUCCESS;
+                continue;
+            }
+            tryNumFrame = 0;
+            stream.bytes.fetch_add(ret < 0 ? 0 : replyBytes, std::memory_order_relaxed);
+        }
+        (void)capture->control.Stop((AudioHandle)capture);
+        adapter->DestroyCapture(adapter, capture);
+        ReleaseLoadAdapter(manager, adapter);
+        stream.result = ret < 0 ? ret : AUDIO_HAL_SUCCESS;
+        stream.cycles++;
+    }
+}
+
+/* least-squares RSS growth over the running samples; the bracketing idle samples are left out */
+double SoakRssSlope(const std::vector<struct AudioSoakSample> &samples)
+{
+    const size_t minimum = 4; // 4: the two idle samples plus at least two running ones
+    if (samples.size() < minimum) {
+        return 0;
+    }
+    double meanTime = 0;
+    double meanRss = 0;
+    size_t count = samples.size() - 2; // 2: skip the first and the last sample
+    for (size_t index = 1; index <= count; index++) {
+        meanTime += samples[index].elapsedNs / NSEC_PER_HOUR;
+        meanRss += samples[index].rssKb;
+    }
+    meanTime /= count;
+    meanRss /= count;
+    double sxx = 0;
+    double sxy = 0;
+    for (size_t index = 1; index <= count; index++) {
+        double dx = samples[index].elapsedNs / NSEC_PER_HOUR - meanTime;
+        sxx += dx * dx;
+        sxy += dx * (samples[index].rssKb - meanRss);
+    }
+    return sxx > 0 ? sxy / sxx : 0;
+}
+
+int32_t QueryRenderPosition(void *handle, uint64_t *frames, struct AudioTimeStamp *time)
+{
+    struct AudioRender *render = static_cast<struct AudioRender *>(handle);
+    return render->GetRenderPosition(render, frames, time);
+}
+
+int32_t QueryCapturePosition(void *handle, uint64_t *frames, struct AudioTimeStamp *time)
+{
+    struct AudioCapture *capture = static_cast<struct AudioCapture *>(handle);
+    return capture->GetCapturePosition(capture, frames, time);
+}
+
+int32_t PositionSampling(void *handle, int32_t (*query)(void *, uint64_t *, struct AudioTimeStamp *),
+    uint32_t durationMs, std::vector<struct PositionSample> &samples, struct AudioClockReport &report)
+{
+    samples.reserve(durationMs * NSEC_PER_MSEC / (POSITION_SAMPLE_INTERVAL_US * NSEC_PER_USEC));
+    int64_t deadlineNs = GetMonotonicNs() + durationMs * NSEC_PER_MSEC;
+    while (GetMonotonicNs() < deadlineNs) {
+        struct AudioTimeStamp time = {};
+        uint64_t frames = 0;
+        int32_t ret = query(handle, &frames, &time);
+        int64_t hostNs = GetMonotonicNs();
+        if (ret < 0) {
+            return ret;
+        }
+        if (!samples.empty() && frames < samples.back().frames) {
+            report.regressions++;
+        }
+        /* a repeated position is the same observation again and would weight the fit towards it */
+        if (samples.empty() || frames != samples.back().frames) {
+            samples.push_back({ time.tvSec * SECTONSEC + time.tvNSec, hostNs, frames });
+        }
+        usleep(POSITION_SAMPLE_INTERVAL_US);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+void PositionFit(const std::vector<struct PositionSample> &samples, struct AudioClockReport &report)
+{
+    report.samples = samples.size();
+    report.hostTimed = std::all_of(samples.begin(), samples.end(),
+        [&samples](const struct PositionSample &sample) { return sample.stampNs == samples.front().stampNs; });
+    if (samples.size() < 2) { // 2: a line needs two points
+        return;
+    }
+    auto timeOf = [&report, &samples](const struct PositionSample &sample) {
+        int64_t ns = report.hostTimed ? sample.hostNs - samples.front().hostNs :
+            sample.stampNs - samples.front().stampNs;
+        return static_cast<double>(ns) / SECTONSEC;
+    };
+    double meanTime = 0;
+    double meanFrames = 0;
+    for (const struct PositionSample &sample : samples) {
+        meanTime += timeOf(sample);
+        meanFrames += static_cast<double>(sample.frames - samples.front().frames);
+    }
+    meanTime /= samples.size();
+    meanFrames /= samples.size();
+    double sxx = 0;
+    double sxy = 0;
+    for (const struct PositionSample &sample : samples) {
+        double dx = timeOf(sample) - meanTime;
+        sxx += dx * dx;
+        sxy += dx * (static_cast<double>(sample.frames - samples.front().frames) - meanFrames);
+    }
+    if (sxx <= 0 || sxy <= 0) {
+        return;
+    }
+    report.framesPerSecond = sxy / sxx;
+    if (report.nominalRate != 0) {
+        report.driftPpm = (report.framesPerSecond / report.nominalRate - 1.0) * PPM;
+    }
+    double sumSquare = 0;
+    double stalenessSum = 0;
+    for (const struct PositionSample &sample : samples) {
+        double fitted = meanFrames + report.framesPerSecond * (timeOf(sample) - meanTime);
+        double residualUs = (static_cast<double>(sample.frames - samples.front().frames) - fitted) /
+            report.framesPerSecond * (SECTONSEC / NSEC_PER_USEC);
+        sumSquare += residualUs * residualUs;
+        report.maxResidualUs = std::max(report.maxResidualUs, std::fabs(residualUs));
+        if (!report.hostTimed) {
+            double stalenessUs = static_cast<double>(sample.hostNs - sample.stampNs) / NSEC_PER_USEC;
+            stalenessSum += stalenessUs;
+            report.maxStalenessUs = std::max(report.maxStalenessUs, stalenessUs);
+        }
+    }
+    report.jitterUs = std::sqrt(sumSquare / samples.size());
+    report.meanStalenessUs = report.hostTimed ? 0 : stalenessSum / samples.size();
+}
+
+int32_t SelectRenderScene(void *handle, const struct AudioSceneDescriptor *scene)
+{
+    struct AudioRender *render = static_cast<struct AudioRender *>(handle);
+    return render->scene.SelectScene(render, scene);
+}
+
+int32_t SelectCaptureScene(void *handle, const struct AudioSceneDescriptor *scene)
+{
+    struct AudioCapture *capture = static_cast<struct AudioCapture *>(handle);
+    return capture->scene.SelectScene(capture, scene);
+}
+
+/* last position seen and when it last moved; carried across dwells so a stall spanning a switch is not split */
+struct SceneStall {
+    uint64_t frames;
+    int64_t movedNs;
+};
+
+int32_t SceneDwell(void *handle, int32_t (*query)(void *, uint64_t *, struct AudioTimeStamp *),
+    struct SceneStall &stall, int64_t &longestNs, uint32_t &regressions)
+{
+    longestNs = 0;
+    int64_t deadlineNs = GetMonotonicNs() + SCENE_DWELL_MS * NSEC_PER_MSEC;
+    while (GetMonotonicNs() < deadlineNs) {
+        struct AudioTimeStamp time = {};
+        uint64_t frames = 0;
+        int32_t ret = query(handle, &frames, &time);
+        int64_t hostNs = GetMonotonicNs();
+        if (ret < 0) {
+            return ret;
+        }
+        if (frames < stall.frames) {
+            regressions++;
+        }
+        if (frames != stall.frames) {
+            stall.frames = frames;
+            stall.movedNs = hostNs;
+        }
+        longestNs = std::max(longestNs, hostNs - stall.movedNs);
+        usleep(POSITION_SAMPLE_INTERVAL_US);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t SceneSwitchRun(void *handle, int32_t (*query)(void *, uint64_t *, struct AudioTimeStamp *),
+    int32_t (*select)(void *, const struct AudioSceneDescriptor *), const enum AudioPortPin *pins,
+    uint32_t pinCount, uint32_t switchCount, struct AudioSceneReport &report)
+{
+    struct AudioTimeStamp time = {};
+    struct SceneStall stall = {};
+    report.baselineStallNs = 0;
+    report.regressions = 0;
+    report.glitches = 0;
+    LatencyHistogramInit(report.callLatency);
+    LatencyHistogramInit(report.glitchLatency);
+    report.switches.clear();
+    report.switches.reserve(switchCount);
+    int32_t ret = query(handle, &stall.frames, &time);
+    if (ret < 0) {
+        return ret;
+    }
+    stall.movedNs = GetMonotonicNs();
+    ret = SceneDwell(handle, query, stall, report.baselineStallNs, report.regressions);
+    if (ret < 0) {
+        return ret;
+    }
+    for (uint32_t index = 0; index < switchCount; index++) {
+        struct AudioSceneSwitch sceneSwitch = {};
+        struct AudioSceneDescriptor scene = {};
+        scene.scene.id = 0;
+        /* pins[0] is where the stream was opened, so the first switch already moves away from it */
+        scene.desc.pins = pins[(index + 1) % pinCount];
+        sceneSwitch.pins = scene.desc.pins;
+        int64_t startNs = GetMonotonicNs();
+        sceneSwitch.result = select(handle, &scene);
+        sceneSwitch.callNs = GetMonotonicNs() - startNs;
+        ret = SceneDwell(handle, query, stall, sceneSwitch.stallNs, report.regressions);
+        if (ret < 0) {
+            return ret;
+        }
+        sceneSwitch.glitchNs = std::max<int64_t>(0, sceneSwitch.stallNs - report.baselineStallNs);
+        if (sceneSwitch.glitchNs > SCENE_GLITCH_TOLERANCE_NS) {
+            report.glitches++;
+        }
+        LatencyHistogramRecord(report.callLatency, sceneSwitch.callNs);
+        LatencyHistogramRecord(report.glitchLatency, sceneSwitch.glitchNs);
+        report.switches.push_back(sceneSwitch);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t SetRenderVolume(void *handle, float value)
+{
+    struct AudioRender *render = static_cast<struct AudioRender *>(handle);
+    return render->volume.SetVolume(render, value);
+}
+
+int32_t SetRenderGain(void *handle, float value)
+{
+    struct AudioRender *render = static_cast<struct AudioRender *>(handle);
+    return render->volume.SetGain(render, value);
+}
+
+int32_t SetCaptureVolume(void *handle, float value)
+{
+    struct AudioCapture *capture = static_cast<struct AudioCapture *>(handle);
+    return capture->volume.SetVolume(capture, value);
+}
+
+int32_t SetCaptureGain(void *handle, float value)
+{
+    struct AudioCapture *capture = static_cast<struct AudioCapture *>(handle);
+    return capture->volume.SetGain(capture, value);
+}
+
+/* drains a running capture on its own thread; only what arrives while the ramp is armed reaches the envelope */
+struct RampMonitor {
+    struct AudioCapture *capture = nullptr;
+    std::atomic<bool> armed {false};
+    std::atomic<bool> stop {false};
+    int32_t result = AUDIO_HAL_SUCCESS;
+    uint64_t bytes = 0;
+    struct AudioPcmEnvelope envelope = {};
+};
+
+void RampMonitorLoop(struct RampMonitor &monitor)
+{
+    struct AudioSampleAttributes attrs = {};
+    InitAttrs(attrs);
+    if (monitor.capture->attr.GetSampleAttributes != nullptr) {
+        (void)monitor.capture->attr.GetSampleAttributes(monitor.capture, &attrs);
+    }
+    monitor.result = PcmEnvelopeInit(monitor.envelope, attrs, 0, ZIPPER_STEP_LIMIT);
+    std::vector<char> frame(PcmFramesToBytes(attrs));
+    int32_t tryNumFrame = 0;
+    while (monitor.result == AUDIO_HAL_SUCCESS && !monitor.stop.load()) {
+        uint64_t replyBytes = 0;
+        int32_t ret = monitor.capture->CaptureFrame(monitor.capture, frame.data(), frame.size(), &replyBytes);
+        /* -1 is the transient "no data yet" of StartRecord, anything else ends the monitor */
+        if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+            continue;
+        }
+        if (ret < 0) {
+            monitor.result = ret;
+            break;
+        }
+        tryNumFrame = 0;
+        if (monitor.armed.load()) {
+            PcmEnvelopeFeed(monitor.envelope, frame.data(), replyBytes);
+            monitor.bytes += replyBytes;
+        }
+    }
+}
+
+float RampValue(const struct AudioRampParams &params, int64_t elapsedNs)
+{
+    int64_t periodNs = static_cast<int64_t>(params.periodMs) * NSEC_PER_MSEC;
+    double phase = static_cast<double>(elapsedNs % periodNs) / periodNs;
+    double triangle = phase < 0.5 ? phase * 2 : 2 - phase * 2; // 0.5, 2: rise over the first half, fall after
+    return static_cast<float>(params.low + (params.high - params.low) * triangle);
+}
+
+/* updates fall due on a fixed grid; a call that overruns its slot is followed back to back until caught up */
+void RampDrive(void *handle, int32_t (*set)(void *, float), const struct AudioRampParams &params,
+    struct AudioRampReport &report)
+{
+    int64_t intervalNs = params.rateHz == 0 ? 0 : SECTONSEC / params.rateHz;
+    int64_t startNs = GetMonotonicNs();
+    int64_t endNs = startNs + static_cast<int64_t>(params.durationMs) * NSEC_PER_MSEC;
+    for (int64_t nowNs = startNs; nowNs < endNs; nowNs = GetMonotonicNs()) {
+        int64_t dueNs = startNs + static_cast<int64_t>(report.updates) * intervalNs;
+        if (dueNs > nowNs) {
+            usleep(static_cast<useconds_t>((dueNs - nowNs) / NSEC_PER_USEC));
+            continue;
+        }
+        int32_t ret = set(handle, RampValue(params, nowNs - startNs));
+        LatencyHistogramRecord(report.histogram, GetMonotonicNs() - nowNs);
+        report.updates++;
+        if (ret < 0) {
+            report.failures++;
+            report.result = report.result == AUDIO_HAL_SUCCESS ? ret : report.result;
+        }
+    }
+    int64_t elapsedNs = GetMonotonicNs() - startNs;
+    report.updatesPerSecond = elapsedNs <= 0 ? 0 : static_cast<double>(report.updates) * SECTONSEC / elapsedNs;
+}
+
+void RampReportInit(struct AudioRampReport &report)
+{
+    report.result = AUDIO_HAL_SUCCESS;
+    report.streamResult = AUDIO_HAL_SUCCESS;
+    report.updates = 0;
+    report.failures = 0;
+    report.updatesPerSecond = 0;
+    report.monitoredBytes = 0;
+    report.envelope = {};
+    LatencyHistogramInit(report.histogram);
+}
+
+void RampMonitorCollect(struct RampMonitor &monitor, struct AudioRampReport &report)
+{
+    PcmEnvelopeResult(monitor.envelope, report.envelope);
+    report.monitoredBytes = monitor.bytes;
+    if (report.streamResult == AUDIO_HAL_SUCCESS) {
+        report.streamResult = monitor.result;
+    }
+}
+
+void StressRender(TestAudioManager *manager, struct AudioStressStream &stream, struct StressGate &gate)
+{
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioRender *render = nullptr;
+    struct AudioSampleAttributes attrs = {};
+    const struct AudioPcmFixture *fixture = nullptr;
+    uint64_t replyBytes = 0;
+    InitAttrs(attrs);
+    stream.result = AudioCreateRender(manager, stream.pins, stream.adapterName, &adapter, &render);
+    /* PlayAudioFile content; the render plays, and the stream is accounted, in the attributes of its frames */
+    if (stream.result == AUDIO_HAL_SUCCESS && GetPcmFixture(AUDIO_FILE, attrs, fixture) != HDF_SUCCESS) {
+        stream.result = HDF_FAILURE;
+    }
+    if (stream.result == AUDIO_HAL_SUCCESS) {
+        attrs = fixture->attrs;
+        stream.result = render->attr.SetSampleAttributes(render, &attrs);
+    }
+    if (stream.result == AUDIO_HAL_SUCCESS) {
+        stream.result = render->control.Start((AudioHandle)render);
+    }
+    StressGateArrive(gate);
+    struct StressClock clock = { GetMonotonicNs(), 0 };
+    while (stream.result == AUDIO_HAL_SUCCESS && GetMonotonicNs() < gate.deadlineNs) {
+        int64_t beginNs = GetMonotonicNs();
+        int32_t ret = render->RenderFrame(render, fixture->frame, fixture->frameSize, &replyBytes);
+        if (ret < 0) {
+            stream.result = ret;
+            break;
+        }
+        StressRecordCall(stream, clock, GetMonotonicNs() - beginNs, replyBytes, attrs);
+    }
+    if (render != nullptr) {
+        (void)render->control.Stop((AudioHandle)render);
+        adapter->DestroyRender(adapter, render);
+        ReleaseLoadAdapter(manager, adapter);
+    }
+}
+
+void StressCapture(TestAudioManager *manager, struct AudioStressStream &stream, struct StressGate &gate)
+{
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioCapture *capture = nullptr;
+    struct AudioSampleAttributes attrs = {};
+    uint64_t replyBytes = 0;
+    int32_t tryNumFrame = 0;
+    InitAttrs(attrs);
+    stream.result = AudioCreateCapture(manager, stream.pins, stream.adapterName, &adapter, &capture);
+    if (stream.result == AUDIO_HAL_SUCCESS) {
+        stream.result = capture->control.Start((AudioHandle)capture);
+    }
+    std::vector<char> frame(BUFFER_LENTH, 0);
+    StressGateArrive(gate);
+    struct StressClock clock = { GetMonotonicNs(), 0 };
+    while (stream.result == AUDIO_HAL_SUCCESS && GetMonotonicNs() < gate.deadlineNs) {
+        int64_t beginNs = GetMonotonicNs();
+        int32_t ret = capture->CaptureFrame(capture, frame.data(), frame.size(), &replyBytes);
+        /* -1 is the transient "no data yet" of StartRecord, anything else ends the stream */
+        if (ret == -1 && tryNumFrame++ <= TRY_NUM_FRAME) {
+            continue;
+        }
+        if (ret < 0) {
+            stream.result = ret;
+            break;
+        }
+        tryNumFrame = 0;
+        StressRecordCall(stream, clock, GetMonotonicNs() - beginNs, replyBytes, attrs);
+    }
+    if (capture != nullptr) {
+        (void)capture->control.Stop((AudioHandle)capture);
+        adapter->DestroyCapture(adapter, capture);
+        ReleaseLoadAdapter(manager, adapter);
+    }
+}
+}
+
+void LatencyHistogramInit(struct AudioLatencyHistogram &histogram)
+{
+    histogram = {};
+    histogram.min = LATENCY_MAX_VALUE;
+}
+
+void LatencyHistogramRecord(struct AudioLatencyHistogram &histogram, int64_t valueNs)
+{
+    if (valueNs < 0) {
+        valueNs = 0;
+    } else if (valueNs > LATENCY_MAX_VALUE) {
+        valueNs = LATENCY_MAX_VALUE;
+    }
+    histogram.buckets[LatencyBucketIndex(valueNs)]++;
+    histogram.count++;
+    histogram.min = valueNs < histogram.min ? valueNs : histogram.min;
+    histogram.max = valueNs > histogram.max ? valueNs : histogram.max;
+    double delta = valueNs - histogram.mean;
+    histogram.mean += delta / histogram.count;
+    histogram.m2 += delta * (valueNs - histogram.mean);
+}
+
+void LatencyHistogramMerge(struct AudioLatencyHistogram &dst, const struct AudioLatencyHistogram &src)
+{
+    if (src.count == 0) {
+        return;
+    }
+    for (int index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+        dst.buckets[index] += src.buckets[index];
+    }
+    uint64_t count = dst.count + src.count;
+    double delta = src.mean - dst.mean;
+    dst.m2 += src.m2 + delta * delta * dst.count * src.count / count;
+    dst.mean += delta * src.count / count;
+    dst.count = count;
+    dst.min = src.min < dst.min ? src.min : dst.min;
+    dst.max = src.max > dst.max ? src.max : dst.max;
+}
+
+int64_t LatencyHistogramPercentile(const struct AudioLatencyHistogram &histogram, double percentile)
+{
+    if (histogram.count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / PERCENT * histogram.count));
+    target = target == 0 ? 1 : target;
+    uint64_t seen = 0;
+    for (int index = 0; index < LATENCY_BUCKET_COUNT; index++) {
+        seen += histogram.buckets[index];
+        if (seen >= target) {
+            int64_t value = LatencyBucketValue(index);
+            value = value < histogram.min ? histogram.min : value;
+            return value > histogram.max ? histogram.max : value;
+        }
+    }
+    return histogram.max;
+}
+
+double LatencyHistogramJitter(const struct AudioLatencyHistogram &histogram)
+{
+    if (histogram.count < 2) { // 2: a deviation needs at least two samples
+        return 0;
+    }
+    return std::sqrt(histogram.m2 / (histogram.count - 1));
+}
+
+void LatencyHistogramPrint(const char *label, const struct AudioLatencyHistogram &histogram)
+{
+    printf("%s: count=%llu min=%lldus p50=%lldus p99=%lldus p99.9=%lldus max=%lldus jitter=%.1fus\n",
+        label, static_cast<unsigned long long>(histogram.count),
+        static_cast<long long>(histogram.count == 0 ? 0 : histogram.min / NSEC_PER_USEC),
+        static_cast<long long>(LatencyHistogramPercentile(histogram, PERCENTILE_50) / NSEC_PER_USEC),
+        static_cast<long long>(LatencyHistogramPercentile(histogram, PERCENTILE_99) / NSEC_PER_USEC),
+        static_cast<long long>(LatencyHistogramPercentile(histogram, PERCENTILE_999) / NSEC_PER_USEC),
+        static_cast<long long>(histogram.max / NSEC_PER_USEC), LatencyHistogramJitter(histogram) / NSEC_PER_USEC);
+}
+
+int32_t RenderFrameLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioLatencyHistogram &histogram)
+{
+    uint64_t replyBytes = 0;
+    int64_t totalNs = 0;
+    int64_t callNs = 0;
+    struct AudioRender *render = audiopara.render;
+    if (render == nullptr || render->RenderFrame == nullptr || frameCount == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    uint32_t bufferSize = PcmFramesToBytes(audiopara.attrs);
+    if (bufferSize == 0) {
+        return HDF_FAILURE;
+    }
+    std::vector<char> frame(bufferSize, 0);
+    int64_t startNs = GetMonotonicNs();
+    for (uint32_t index = 0; index < frameCount; index++) {
+        int64_t beginNs = GetMonotonicNs();
+        int32_t ret = render->RenderFrame(render, frame.data(), bufferSize, &replyBytes);
+        callNs = GetMonotonicNs() - beginNs;
+        if (ret < 0) {
+            return ret;
+        }
+        LatencyHistogramRecord(histogram, callNs);
+        totalNs += callNs;
+    }
+    UpdateDelayTime(audiopara, startNs, GetMonotonicNs(), totalNs, callNs, frameCount);
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t CaptureFrameLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioLatencyHistogram &histogram)
+{
+    uint64_t replyBytes = 0;
+    int64_t totalNs = 0;
+    int64_t callNs = 0;
+    struct AudioCapture *capture = audiopara.capture;
+    if (capture == nullptr || capture->CaptureFrame == nullptr || frameCount == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    uint32_t bufferSize = FRAME_COUNT * PcmFramesToBytes(audiopara.attrs);
+    if (bufferSize == 0) {
+        return HDF_FAILURE;
+    }
+    std::vector<char> frame(bufferSize, 0);
+    int64_t startNs = GetMonotonicNs();
+    for (uint32_t index = 0; index < frameCount; index++) {
+        int64_t beginNs = GetMonotonicNs();
+        int32_t ret = capture->CaptureFrame(capture, frame.data(), bufferSize, &replyBytes);
+        callNs = GetMonotonicNs() - beginNs;
+        if (ret < 0) {
+            return ret;
+        }
+        LatencyHistogramRecord(histogram, callNs);
+        totalNs += callNs;
+    }
+    UpdateDelayTime(audiopara, startNs, GetMonotonicNs(), totalNs, callNs, frameCount);
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t RenderNonblockLatency(struct PrepareAudioPara &audiopara, uint32_t frameCount,
+    struct AudioNonblockStats &stats)
+{
+    uint64_t replyBytes = 0;
+    struct AudioRender *render = audiopara.render;
+    if (render == nullptr || render->RenderFrame == nullptr || render->RegCallback == nullptr || frameCount == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    uint32_t bufferSize = PcmFramesToBytes(audiopara.attrs);
+    if (bufferSize == 0) {
+        return HDF_FAILURE;
+    }
+    std::vector<char> frame(bufferSize, 0);
+    stats.submitted = 0;
+    stats.completed = 0;
+    stats.renderFull = 0;
+    stats.timeouts = 0;
+    LatencyHistogramInit(stats.histogram);
+    int64_t sinceNs = GetMonotonicNs();
+    struct AudioRenderEventQueue &queue = RenderEventQueueFor(render);
+    uint64_t droppedBefore = queue.dropped.load(std::memory_order_relaxed);
+    std::deque<int64_t> pending;
+    int32_t ret = render->RegCallback(render, AudioRenderEventCallback, &queue);
+    if (ret < 0) {
+        return ret;
+    }
+    for (uint32_t index = 0; index < frameCount && ret >= 0; index++) {
+        /* a HAL that never signals completion only costs one timeout, then frames are submitted unpaced */
+        bool signalling = stats.timeouts == 0 || stats.completed > 0;
+        if (signalling && !NonblockWait(queue, pending, stats, NONBLOCK_MAX_OUTSTANDING - 1, sinceNs)) {
+            pending.pop_front();
+        }
+        if (!signalling) {
+            (void)NonblockDrain(queue, pending, stats, sinceNs);
+            pending.clear();
+        }
+        pending.push_back(GetMonotonicNs());
+        ret = render->RenderFrame(render, frame.data(), bufferSize, &replyBytes);
+        stats.submitted++;
+    }
+    bool signalling = stats.timeouts == 0 || stats.completed > 0;
+    if (ret >= 0 && signalling && !NonblockWait(queue, pending, stats, 0, sinceNs)) {
+        pending.clear();
+    }
+    /* detach the queue; the HAL may keep signalling it until the render is destroyed */
+    (void)render->RegCallback(render, AudioRenderCallback, nullptr);
+    (void)NonblockDrain(queue, pending, stats, sinceNs);
+    stats.dropped = queue.dropped.load(std::memory_order_relaxed) - droppedBefore;
+    return ret < 0 ? ret : AUDIO_HAL_SUCCESS;
+}
+
+void NonblockStatsPrint(const char *label, const struct AudioNonblockStats &stats)
+{
+    char text[STRESS_LABEL_LENGTH] = {0};
+    (void)snprintf(text, sizeof(text), "%s submitted=%llu completed=%llu full=%llu timeouts=%llu dropped=%llu",
+        label, static_cast<unsigned long long>(stats.submitted), static_cast<unsigned long long>(stats.completed),
+        static_cast<unsigned long long>(stats.renderFull), static_cast<unsigned long long>(stats.timeouts),
+        static_cast<unsigned long long>(stats.dropped));
+    LatencyHistogramPrint(text, stats.histogram);
+}
+
+int32_t RenderAttrSweep(struct PrepareAudioPara &audiopara, const struct AudioAttrSweep &sweep,
+    std::vector<struct AudioAttrSweepCase> &cases)
+{
+    struct AudioRender *render = audiopara.render;
+    if (render == nullptr || render->RenderFrame == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    return AttrSweepRun(audiopara, sweep, cases, AttrSweepRenderCase);
+}
+
+int32_t CaptureAttrSweep(struct PrepareAudioPara &audiopara, const struct AudioAttrSweep &sweep,
+    std::vector<struct AudioAttrSweepCase> &cases)
+{
+    struct AudioCapture *capture = audiopara.capture;
+    if (capture == nullptr || capture->CaptureFrame == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    return AttrSweepRun(audiopara, sweep, cases, AttrSweepCaptureCase);
+}
+
+void AttrSweepPrintCsv(const char *label, const std::vector<struct AudioAttrSweepCase> &cases)
+{
+    printf("%s,bits,channels,rate,period,result,matched,setget_us,first_frame_us\n", label);
+    for (const struct AudioAttrSweepCase &sweepCase : cases) {
+        printf("%s,%u,%u,%u,%u,%d,%d,%lld,%lld\n", label, PcmFormatToBits(sweepCase.format), sweepCase.channelCount,
+            sweepCase.sampleRate, sweepCase.period, sweepCase.result, sweepCase.matched ? 1 : 0,
+            static_cast<long long>(sweepCase.setGetNs / NSEC_PER_USEC),
+            static_cast<long long>(sweepCase.firstFrameNs < 0 ? -1 : sweepCase.firstFrameNs / NSEC_PER_USEC));
+    }
+}
+
+int32_t RenderPositionAnalyze(struct AudioRender *render, uint32_t durationMs, struct AudioClockReport &report)
+{
+    struct AudioSampleAttributes attrs = {};
+    std::vector<struct PositionSample> samples;
+    if (render == nullptr || render->GetRenderPosition == nullptr || durationMs == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    report = {};
+    if (render->attr.GetSampleAttributes != nullptr &&
+        render->attr.GetSampleAttributes(render, &attrs) == AUDIO_HAL_SUCCESS) {
+        report.nominalRate = attrs.sampleRate;
+    }
+    int32_t ret = PositionSampling(render, QueryRenderPosition, durationMs, samples, report);
+    if (ret < 0) {
+        return ret;
+    }
+    PositionFit(samples, report);
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t CapturePositionAnalyze(struct AudioCapture *capture, uint32_t durationMs, struct AudioClockReport &report)
+{
+    struct AudioSampleAttributes attrs = {};
+    std::vector<struct PositionSample> samples;
+    if (capture == nullptr || capture->GetCapturePosition == nullptr || durationMs == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    report = {};
+    if (capture->attr.GetSampleAttributes != nullptr &&
+        capture->attr.GetSampleAttributes(capture, &attrs) == AUDIO_HAL_SUCCESS) {
+        report.nominalRate = attrs.sampleRate;
+    }
+    int32_t ret = PositionSampling(capture, QueryCapturePosition, durationMs, samples, report);
+    if (ret < 0) {
+        return ret;
+    }
+    PositionFit(samples, report);
+    return AUDIO_HAL_SUCCESS;
+}
+
+void ClockReportPrint(const char *label, const struct AudioClockReport &report)
+{
+    printf("%s: samples=%u regressions=%u %s rate=%.1f/%uHz drift=%.1fppm jitter=%.1fus maxResidual=%.1fus "
+        "staleness=%.1fus max=%.1fus\n", label, report.samples, report.regressions,
+        report.hostTimed ? "host-timed" : "hal-timed", report.framesPerSecond, report.nominalRate, report.driftPpm,
+        report.jitterUs, report.maxResidualUs, report.meanStalenessUs, report.maxStalenessUs);
+}
+
+int32_t RenderSceneSwitchRun(struct AudioRender *render, const enum AudioPortPin *pins, uint32_t pinCount,
+    uint32_t switchCount, struct AudioSceneReport &report)
+{
+    if (render == nullptr || render->GetRenderPosition == nullptr || render->scene.SelectScene == nullptr ||
+        pins == nullptr || pinCount == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    return SceneSwitchRun(render, QueryRenderPosition, SelectRenderScene, pins, pinCount, switchCount, report);
+}
+
+int32_t CaptureSceneSwitchRun(struct AudioCapture *capture, const enum AudioPortPin *pins, uint32_t pinCount,
+    uint32_t switchCount, struct AudioSceneReport &report)
+{
+    if (capture == nullptr || capture->GetCapturePosition == nullptr || capture->scene.SelectScene == nullptr ||
+        pins == nullptr || pinCount == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    return SceneSwitchRun(capture, QueryCapturePosition, SelectCaptureScene, pins, pinCount, switchCount, report);
+}
+
+void RampParamsDefault(struct AudioRampParams &params, enum AudioRampTarget target, float low, float high)
+{
+    params.target = target;
+    params.low = low;
+    params.high = high;
+    params.rateHz = RAMP_RATE_HZ;
+    params.periodMs = RAMP_PERIOD_MS;
+    params.durationMs = RAMP_DURATION_MS;
+}
+
+int32_t RenderRampRun(struct AudioRender *render, struct AudioCapture *monitor, const struct AudioRampParams &params,
+    struct AudioRampReport &report)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioSynthParams synthParams = {};
+    struct AudioPcmSynth synth = {};
+    if (render == nullptr || render->volume.SetVolume == nullptr || render->volume.SetGain == nullptr ||
+        params.periodMs == 0 || params.durationMs == 0 || (monitor != nullptr && monitor->CaptureFrame == nullptr)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    RampReportInit(report);
+    InitAttrs(attrs);
+    if (render->attr.GetSampleAttributes != nullptr) {
+        (void)render->attr.GetSampleAttributes(render, &attrs);
+    }
+    /* a steady tone, so every step in the monitored envelope comes from the ramp */
+    PcmSynthDefault(synthParams, AUDIO_SYNTH_SWEEP);
+    synthParams.startHz = SYNTH_TONE_HZ;
+    synthParams.endHz = SYNTH_TONE_HZ;
+    int32_t ret = PcmSynthInit(synth, attrs, synthParams);
+    if (ret < 0) {
+        return ret;
+    }
+    int32_t (*set)(void *, float) = params.target == AUDIO_RAMP_GAIN ? SetRenderGain : SetRenderVolume;
+    /* park the stream where the ramp starts, so the jump from the previous setting is not taken for a zipper */
+    ret = set(render, params.low);
+    if (ret < 0) {
+        return ret;
+    }
+    if (monitor != nullptr) {
+        ret = monitor->control.Start((AudioHandle)monitor);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+    uint64_t frames = static_cast<uint64_t>(attrs.sampleRate) * (params.durationMs + RAMP_LEAD_MS * 2) / MSEC_PER_SEC;
+    std::thread player([&]() { report.streamResult = FrameStartSynth(render, synth, attrs, frames); });
+    struct RampMonitor watcher;
+    watcher.capture = monitor;
+    std::thread reader;
+    if (monitor != nullptr) {
+        reader = std::thread(RampMonitorLoop, std::ref(watcher));
+    }
+    usleep(RAMP_LEAD_MS * (NSEC_PER_MSEC / NSEC_PER_USEC));
+    watcher.armed = true;
+    RampDrive(render, set, params, report);
+    watcher.armed = false;
+    player.join();
+    watcher.stop = true;
+    if (reader.joinable()) {
+        reader.join();
+        (void)monitor->control.Stop((AudioHandle)monitor);
+        RampMonitorCollect(watcher, report);
+    }
+    (void)render->control.Stop((AudioHandle)render);
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t CaptureRampRun(struct AudioCapture *capture, const struct AudioRampParams &params,
+    struct AudioRampReport &report)
+{
+    if (capture == nullptr || capture->CaptureFrame == nullptr || capture->volume.SetVolume == nullptr ||
+        capture->volume.SetGain == nullptr || params.periodMs == 0 || params.durationMs == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    RampReportInit(report);
+    int32_t (*set)(void *, float) = params.target == AUDIO_RAMP_GAIN ? SetCaptureGain : SetCaptureVolume;
+    int32_t ret = set(capture, params.low);
+    if (ret < 0) {
+        return ret;
+    }
+    ret = capture->control.Start((AudioHandle)capture);
+    if (ret < 0) {
+        return ret;
+    }
+    struct RampMonitor watcher;
+    watcher.capture = capture;
+    std::thread reader(RampMonitorLoop, std::ref(watcher));
+    usleep(RAMP_LEAD_MS * (NSEC_PER_MSEC / NSEC_PER_USEC));
+    watcher.armed = true;
+    RampDrive(capture, set, params, report);
+    watcher.armed = false;
+    watcher.stop = true;
+    reader.join();
+    RampMonitorCollect(watcher, report);
+    (void)capture->control.Stop((AudioHandle)capture);
+    return AUDIO_HAL_SUCCESS;
+}
+
+void RampReportPrint(const char *label, const struct AudioRampReport &report)
+{
+    char text[STRESS_LABEL_LENGTH] = {0};
+    printf("%s: updates=%llu failures=%llu ret=%d rate=%.0f/s stream=%d monitored=%lluB blocks=%llu zipper=%llu "
+        "maxStep=%.4f level=%.4f..%.4f\n", label, static_cast<unsigned long long>(report.updates),
+        static_cast<unsigned long long>(report.failures), report.result, report.updatesPerSecond, report.streamResult,
+        static_cast<unsigned long long>(report.monitoredBytes), static_cast<unsigned long long>(report.envelope.blocks),
+        static_cast<unsigned long long>(report.envelope.zipperSteps), report.envelope.maxStep,
+        report.envelope.minLevel, report.envelope.maxLevel);
+    (void)snprintf(text, sizeof(text), "%s set call", label);
+    LatencyHistogramPrint(text, report.histogram);
+}
+
+void SceneReportPrint(const char *label, const struct AudioSceneReport &report)
+{
+    char text[STRESS_LABEL_LENGTH] = {0};
+    printf("%s: switches=%zu glitches=%u regressions=%u baselineStall=%lldus\n", label, report.switches.size(),
+        report.glitches, report.regressions, static_cast<long long>(report.baselineStallNs / NSEC_PER_USEC));
+    for (const struct AudioSceneSwitch &sceneSwitch : report.switches) {
+        printf("%s: pins=0x%x ret=%d call=%lldus stall=%lldus glitch=%lldus\n", label,
+            static_cast<uint32_t>(sceneSwitch.pins), sceneSwitch.result,
+            static_cast<long long>(sceneSwitch.callNs / NSEC_PER_USEC),
+            static_cast<long long>(sceneSwitch.stallNs / NSEC_PER_USEC),
+            static_cast<long long>(sceneSwitch.glitchNs / NSEC_PER_USEC));
+    }
+    (void)snprintf(text, sizeof(text), "%s SelectScene", label);
+    LatencyHistogramPrint(text, report.callLatency);
+    (void)snprintf(text, sizeof(text), "%s glitch", label);
+    LatencyHistogramPrint(text, report.glitchLatency);
+}
+
+int32_t AudioStressRun(TestAudioManager *manager, uint32_t renderCount, uint32_t captureCount, uint32_t durationMs,
+    struct AudioStressReport &report)
+{
+    uint32_t streamCount = renderCount + captureCount;
+    if (manager == nullptr || streamCount == 0 || streamCount > STRESS_MAX_STREAMS) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    report.streamCount = streamCount;
+    report.bytes = 0;
+    report.xruns = 0;
+    LatencyHistogramInit(report.histogram);
+    struct StressGate gate;
+    gate.pending = streamCount;
+    gate.durationNs = static_cast<int64_t>(durationMs) * NSEC_PER_MSEC;
+    std::vector<std::thread> pool;
+    for (uint32_t index = 0; index < streamCount; index++) {
+        struct AudioStressStream &stream = report.streams[index];
+        bool isRender = index < renderCount;
+        /* renders alternate between the two output adapters so the codec sees more than one client path */
+        stream.portType = isRender ? PORT_OUT : PORT_IN;
+        stream.adapterName = (isRender && index % 2 == 1) ? ADAPTER_NAME_OUT.c_str() : ADAPTER_NAME.c_str();
+        stream.pins = isRender ? PIN_OUT_SPEAKER : PIN_IN_MIC;
+        stream.result = AUDIO_HAL_SUCCESS;
+        stream.bytes = 0;
+        stream.frames = 0;
+        stream.xruns = 0;
+        LatencyHistogramInit(stream.histogram);
+        if (isRender) {
+            pool.emplace_back(StressRender, manager, std::ref(stream), std::ref(gate));
+        } else {
+            pool.emplace_back(StressCapture, manager, std::ref(stream), std::ref(gate));
+        }
+    }
+    int64_t startNs = GetMonotonicNs();
+    for (std::thread &worker : pool) {
+        worker.join();
+    }
+    report.elapsedNs = GetMonotonicNs() - startNs;
+    int32_t ret = AUDIO_HAL_SUCCESS;
+    for (uint32_t index = 0; index < streamCount; index++) {
+        const struct AudioStressStream &stream = report.streams[index];
+        report.bytes += stream.bytes;
+        report.xruns += stream.xruns;
+        LatencyHistogramMerge(report.histogram, stream.histogram);
+        ret = stream.result < 0 ? stream.result : ret;
+    }
+    report.bytesPerSecond = report.elapsedNs > 0 ?
+        static_cast<double>(report.bytes) * SECTONSEC / report.elapsedNs : 0;
+    return ret;
+}
+
+uint32_t SoakDurationMs()
+{
+    const char *value = getenv("AUDIO_SOAK_DURATION_MS");
+    if (value == nullptr) {
+        return SOAK_DURATION_MS;
+    }
+    char *end = nullptr;
+    unsigned long durationMs = strtoul(value, &end, 10); // 10: decimal
+    if (end == value || *end != '\0' || durationMs == 0 || durationMs > UINT32_MAX) {
+        return SOAK_DURATION_MS;
+    }
+    return static_cast<uint32_t>(durationMs);
+}
+
+int32_t AudioSoakRun(TestAudioManager *manager, uint32_t durationMs, struct AudioSoakReport &report)
+{
+    if (manager == nullptr || durationMs == 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct SoakStream render;
+    struct SoakStream capture;
+    report.samples.clear();
+    report.samples.reserve(durationMs / SOAK_SAMPLE_INTERVAL_MS + 2); // 2: the idle samples before and after
+    int64_t startNs = GetMonotonicNs();
+    int64_t deadlineNs = startNs + static_cast<int64_t>(durationMs) * NSEC_PER_MSEC;
+    SoakTakeSample(manager, startNs, render, capture, report);
+    std::thread renderThread(SoakRender, manager, std::ref(render), deadlineNs);
+    std::thread captureThread(SoakCapture, manager, std::ref(capture), deadlineNs);
+    for (int64_t nextNs = startNs + SOAK_SAMPLE_INTERVAL_MS * NSEC_PER_MSEC; nextNs < deadlineNs;
+        nextNs += SOAK_SAMPLE_INTERVAL_MS * NSEC_PER_MSEC) {
+        int64_t waitNs = nextNs - GetMonotonicNs();
+        if (waitNs > 0) {
+            usleep(waitNs / NSEC_PER_USEC);
+        }
+        SoakTakeSample(manager, startNs, render, capture, report);
+    }
+    renderThread.join();
+    captureThread.join();
+    SoakTakeSample(manager, startNs, render, capture, report);
+    report.renderResult = render.result;
+    report.captureResult = capture.result;
+    report.renderCycles = render.cycles;
+    report.captureCycles = capture.cycles;
+    report.rssSlopeKbPerHour = SoakRssSlope(report.samples);
+    return render.result < 0 ? render.result : capture.result;
+}
+
+void AudioSoakPrint(const struct AudioSoakReport &report)
+{
+    for (size_t index = 0; index < report.samples.size(); index++) {
+        const struct AudioSoakSample &sample = report.samples[index];
+        const struct AudioSoakSample &previous = report.samples[index == 0 ? 0 : index - 1];
+        int64_t intervalNs = sample.elapsedNs - previous.elapsedNs;
+        double renderRate = intervalNs > 0 ?
+            static_cast<double>(sample.renderBytes - previous.renderBytes) * SECTONSEC / intervalNs : 0;
+        double captureRate = intervalNs > 0 ?
+            static_cast<double>(sample.captureBytes - previous.captureBytes) * SECTONSEC / intervalNs : 0;
+        printf("soak %llds rss=%lluKB fds=%u adapters=%u refs=%u render=%.0fbytes/s capture=%.0fbytes/s\n",
+            static_cast<long long>(sample.elapsedNs / SECTONSEC), static_cast<unsigned long long>(sample.rssKb),
+            sample.fds, sample.adapters, sample.adapterReferences, renderRate, captureRate);
+    }
+    printf("soak: render ret=%d cycles=%u capture ret=%d cycles=%u rss growth=%.1fKB/h\n", report.renderResult,
+        report.renderCycles, report.captureResult, report.captureCycles, report.rssSlopeKbPerHour);
+}
+
+void AudioStressPrint(const struct AudioStressReport &report)
+{
+    char label[STRESS_LABEL_LENGTH] = {0};
+    for (uint32_t index = 0; index < report.streamCount; index++) {
+        const struct AudioStressStream &stream = report.streams[index];
+        (void)snprintf(label, sizeof(label), "stream %u %s %s ret=%d bytes=%llu xruns=%llu", index,
+            stream.portType == PORT_OUT ? "render" : "capture", stream.adapterName, stream.result,
+            static_cast<unsigned long long>(stream.bytes), static_cast<unsigned long long>(stream.xruns));
+        LatencyHistogramPrint(label, stream.histogram);
+    }
+    (void)snprintf(label, sizeof(label), "all %u streams %.0f bytes/s xruns=%llu", report.streamCount,
+        report.bytesPerSecond, static_cast<unsigned long long>(report.xruns));
+    LatencyHistogramPrint(label, report.histogram);
+}
+
+void MmapStreamPrint(const char *label, const struct AudioMmapStreamStats &stats)
+{
+    printf("%s: frames=%llu polls=%llu stalls=%llu elapsed=%lldms rate=%.0fbytes/s drift=%.1fppm maxLag=%lldus\n",
+        label, static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.polls),
+        static_cast<unsigned long long>(stats.stalls), static_cast<long long>(stats.elapsedNs / NSEC_PER_MSEC),
+        stats.bytesPerSecond, stats.driftPpm, static_cast<long long>(stats.maxLagNs / NSEC_PER_USEC));
+}
+}
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_loopback.h
+ *
+ * @brief Declares the loopback stand-in for the audio HAL, which plays rendered periods back into capture.
+ *
+ * The library exports the same entry points as libhdi_audio and libhdi_audio_client. Point the test loader at
+ * it with AUDIO_HAL_LIBRARY and configure it with the AUDIO_LOOPBACK_* environment variables below, or call
+ * AudioLoopbackSetConfig through dlsym.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef AUDIO_LOOPBACK_H
+#define AUDIO_LOOPBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "audio_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_LOOPBACK_LATENCY_ENV "AUDIO_LOOPBACK_LATENCY_US"
+#define AUDIO_LOOPBACK_JITTER_ENV "AUDIO_LOOPBACK_JITTER_US"
+#define AUDIO_LOOPBACK_FAIL_ENV "AUDIO_LOOPBACK_FAIL_PERMILLE"
+#define AUDIO_LOOPBACK_UNPACED_ENV "AUDIO_LOOPBACK_UNPACED"
+
+struct AudioLoopbackConfig {
+    uint32_t latencyUs;    /* delay between a frame being played and it becoming capturable */
+    uint32_t jitterUs;     /* uniformly distributed extra delay per rendered period */
+    uint32_t failPermille; /* RenderFrame and CaptureFrame calls that fail with -1, per thousand */
+    bool paced;            /* block RenderFrame and CaptureFrame at the stream rate like a real device */
+};
+
+struct AudioLoopbackStats {
+    uint64_t renderedBytes;
+    uint64_t capturedBytes;  /* loopback data handed to capture, silence fill excluded */
+    uint64_t droppedBytes;   /* rendered data discarded because nothing captured it in time */
+    uint64_t injectedFailures;
+};
+
+struct AudioManager *GetAudioManagerFuncs(void);
+
+struct AudioManager *GetAudioProxyManagerFuncs(void);
+
+void AudioLoopbackSetConfig(const struct AudioLoopbackConfig *config);
+
+void AudioLoopbackGetConfig(struct AudioLoopbackConfig *config);
+
+void AudioLoopbackGetStats(struct AudioLoopbackStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // AUDIO_LOOPBACK_H
@@ -0,0 +1,1205 @@
+/**
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_loopback.cpp
+ *
+ * @brief Implements the loopback stand-in for the audio HAL.
+ *
+ * Every adapter owns one loop. A render stream plays its periods against a monotonic clock at the stream rate
+ * and queues them on the loop, ready latencyUs (plus jitter) after they were played. A capture stream on the same
+ * adapter returns whatever is ready when its own clock reaches the end of the requested period, and silence for
+ * the rest. Data is looped byte for byte, so render and capture are expected to use the same attributes.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+#include <time.h>
+#include "audio_loopback.h"
+
+namespace HMOS {
+namespace Audio {
+namespace {
+const int64_t NSEC_PER_SEC = 1000000000;
+const int64_t NSEC_PER_USEC = 1000;
+const uint32_t USEC_PER_MSEC = 1000;
+const uint32_t BITS_PER_BYTE = 8;
+const uint32_t PERMILLE = 1000;
+const uint32_t MAX_CHANNEL_COUNT = 2;
+const uint32_t MAX_SAMPLE_RATE = 192000;
+const int32_t FRAME_FAILURE = -1;
+const uint32_t PIN_INPUT_MASK = 0x8000000;
+/* how far RenderFrame may run ahead of the playback clock before it blocks */
+const int64_t LOOPBACK_BUFFER_NS = 20000000;
+/* rendered data nobody captured is dropped after this long, or once the loop holds this much */
+const int64_t LOOPBACK_QUEUE_NS = 2000000000;
+const size_t LOOPBACK_QUEUE_BYTES = 4 * 1024 * 1024;
+const float GAIN_MIN = 0.0f;
+const float GAIN_MAX = 15.0f;
+const size_t EXTRA_PARAMS_LENGTH = 1024;
+const uint32_t DEC = 10;
+
+struct LoopChunk {
+    int64_t readyNs;
+    std::vector<uint8_t> data;
+    size_t offset;
+};
+
+struct Loop {
+    std::mutex mutex;
+    std::deque<struct LoopChunk> chunks;
+    size_t bytes = 0;
+};
+
+struct StreamClock {
+    bool started;
+    bool paused;
+    int64_t startNs;   /* moved forward by pauses and underruns, so frame N is played at startNs + N / rate */
+    int64_t pausedAtNs;
+    uint64_t frames;   /* frames handed over by RenderFrame or CaptureFrame since Start */
+};
+
+struct LoopbackStream {
+    std::mutex mutex;
+    struct AudioSampleAttributes attrs;
+    struct AudioDeviceDescriptor desc;
+    struct AudioSceneDescriptor scene;
+    struct StreamClock clock;
+    bool mute;
+    float volume;
+    float appliedVolume; /* volume at the end of the last rendered period */
+    float gain;
+    std::string extraParams;
+    void *mmapAddress;
+    size_t mmapLength;
+    struct Loop *loop;
+};
+
+struct LoopbackRender {
+    static const int32_t BUSY = AUDIO_HAL_ERR_AO_BUSY;
+    struct AudioRender render; /* first, so the handle and the object share an address */
+    struct LoopbackStream stream;
+    enum AudioChannelMode channelMode;
+    RenderCallback callback;
+    void *cookie;
+};
+
+struct LoopbackCapture {
+    static const int32_t BUSY = AUDIO_HAL_ERR_AI_BUSY;
+    struct AudioCapture capture;
+    struct LoopbackStream stream;
+};
+
+struct LoopbackAdapter {
+    struct AudioAdapter adapter;
+    const struct AudioAdapterDescriptor *descriptor;
+    struct Loop *loop;
+    enum AudioPortPassthroughMode mode;
+    std::atomic<bool> capturing {false}; /* the in-process HAL opens one capture per adapter */
+};
+
+struct LoopbackConfigState {
+    std::atomic<uint32_t> latencyUs {0};
+    std::atomic<uint32_t> jitterUs {0};
+    std::atomic<uint32_t> failPermille {0};
+    std::atomic<bool> paced {true};
+};
+
+struct LoopbackStatsState {
+    std::atomic<uint64_t> renderedBytes {0};
+    std::atomic<uint64_t> capturedBytes {0};
+    std::atomic<uint64_t> droppedBytes {0};
+    std::atomic<uint64_t> injectedFailures {0};
+};
+
+struct AudioPort g_primaryPorts[] = {
+    { PORT_OUT, 0, "AOP" },
+    { PORT_IN, 1, "AIP" },
+};
+struct AudioPort g_extPorts[] = {
+    { PORT_OUT, 0, "AOP" },
+    { PORT_IN, 1, "AIP" },
+};
+struct AudioPort g_usbPorts[] = {
+    { PORT_OUT, 0, "AOP" },
+    { PORT_IN, 1, "AIP" },
+};
+struct AudioAdapterDescriptor g_descriptors[] = {
+    { "primary", sizeof(g_primaryPorts) / sizeof(g_primaryPorts[0]), g_primaryPorts },
+    { "primary_ext", sizeof(g_extPorts) / sizeof(g_extPorts[0]), g_extPorts },
+    { "usb", sizeof(g_usbPorts) / sizeof(g_usbPorts[0]), g_usbPorts },
+};
+const int DESCRIPTOR_COUNT = sizeof(g_descriptors) / sizeof(g_descriptors[0]);
+enum AudioFormat g_formats[] = {
+    AUDIO_FORMAT_PCM_8_BIT, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_24_BIT, AUDIO_FORMAT_PCM_32_BIT
+};
+struct AudioSubPortCapability g_subPorts[] = {
+    { 0, "AOP", PORT_PASSTHROUGH_LPCM },
+};
+
+struct Loop g_loops[DESCRIPTOR_COUNT];
+struct LoopbackConfigState g_config;
+struct LoopbackStatsState g_stats;
+struct AudioManager g_manager;
+std::once_flag g_managerOnce;
+
+int64_t NowNs()
+{
+    struct timespec now = {};
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * NSEC_PER_SEC + now.tv_nsec;
+}
+
+void SleepUntil(int64_t deadlineNs)
+{
+    struct timespec deadline = {};
+    deadline.tv_sec = deadlineNs / NSEC_PER_SEC;
+    deadline.tv_nsec = deadlineNs % NSEC_PER_SEC;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+
+int64_t FramesToNs(uint64_t frames, uint32_t rate)
+{
+    return static_cast<int64_t>(frames / rate) * NSEC_PER_SEC +
+        static_cast<int64_t>(frames % rate) * NSEC_PER_SEC / rate;
+}
+
+uint32_t FormatBits(enum AudioFormat format)
+{
+    switch (format) {
+        case AUDIO_FORMAT_PCM_8_BIT:
+            return 8;  // 8: bits per sample
+        case AUDIO_FORMAT_PCM_16_BIT:
+            return 16; // 16: bits per sample
+        case AUDIO_FORMAT_PCM_24_BIT:
+            return 24; // 24: bits per sample
+        case AUDIO_FORMAT_PCM_32_BIT:
+            return 32; // 32: bits per sample
+        default:
+            return 0;
+    }
+}
+
+uint32_t FrameBytes(const struct AudioSampleAttributes &attrs)
+{
+    return FormatBits(attrs.format) / BITS_PER_BYTE * attrs.channelCount;
+}
+
+/* the pin has to match the direction and the port has to exist on the adapter; like the device HAL, the
+ * port's own direction is not checked */
+bool DeviceSupported(const struct LoopbackAdapter &adapter, const struct AudioDeviceDescriptor &desc,
+    enum AudioPortDirection dir)
+{
+    bool input = (static_cast<uint32_t>(desc.pins) & PIN_INPUT_MASK) != 0;
+    if (desc.pins == PIN_NONE || input != (dir == PORT_IN)) {
+        return false;
+    }
+    for (uint32_t index = 0; index < adapter.descriptor->portNum; index++) {
+        const struct AudioPort &port = adapter.descriptor->ports[index];
+        if (port.portId == desc.portId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AttrsSupported(const struct AudioSampleAttributes &attrs)
+{
+    return FormatBits(attrs.format) != 0 && attrs.channelCount > 0 && attrs.channelCount <= MAX_CHANNEL_COUNT &&
+        attrs.sampleRate > 0 && attrs.sampleRate <= MAX_SAMPLE_RATE;
+}
+
+uint32_t ReadEnv(const char *name, uint32_t fallback)
+{
+    const char *value = getenv(name);
+    if (value == nullptr) {
+        return fallback;
+    }
+    char *end = nullptr;
+    unsigned long parsed = strtoul(value, &end, DEC);
+    return (end == value || *end != '\0') ? fallback : static_cast<uint32_t>(parsed);
+}
+
+uint32_t RandomBelow(uint32_t bound)
+{
+    static thread_local std::minstd_rand random(std::random_device {}());
+    return std::uniform_int_distribution<uint32_t>(0, bound - 1)(random);
+}
+
+bool InjectFailure()
+{
+    uint32_t failPermille = g_config.failPermille.load(std::memory_order_relaxed);
+    if (failPermille == 0 || RandomBelow(PERMILLE) >= failPermille) {
+        return false;
+    }
+    g_stats.injectedFailures.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+/* frames played by the clock at nowNs; the clock stands still while paused */
+uint64_t ClockFrames(const struct StreamClock &clock, uint32_t rate, int64_t nowNs)
+{
+    if (!clock.started) {
+        return 0;
+    }
+    int64_t at = clock.paused ? clock.pausedAtNs : nowNs;
+    if (at <= clock.startNs) {
+        return 0;
+    }
+    int64_t elapsedNs = at - clock.startNs;
+    return static_cast<uint64_t>(elapsedNs / NSEC_PER_SEC) * rate +
+        static_cast<uint64_t>(elapsedNs % NSEC_PER_SEC) * rate / NSEC_PER_SEC;
+}
+
+void LoopTrim(struct Loop &loop, int64_t nowNs)
+{
+    while (!loop.chunks.empty() &&
+        (loop.bytes > LOOPBACK_QUEUE_BYTES || loop.chunks.front().readyNs < nowNs - LOOPBACK_QUEUE_NS)) {
+        size_t left = loop.chunks.front().data.size() - loop.chunks.front().offset;
+        g_stats.droppedBytes.fetch_add(left, std::memory_order_relaxed);
+        loop.bytes -= left;
+        loop.chunks.pop_front();
+    }
+}
+
+void LoopPush(struct Loop &loop, int64_t readyNs, std::vector<uint8_t> &&data)
+{
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    loop.bytes += data.size();
+    /* jitter must not reorder periods, a later period is never ready before an earlier one */
+    if (!loop.chunks.empty() && loop.chunks.back().readyNs > readyNs) {
+        readyNs = loop.chunks.back().readyNs;
+    }
+    loop.chunks.push_back({ readyNs, std::move(data), 0 });
+    LoopTrim(loop, NowNs());
+}
+
+size_t LoopPull(struct Loop &loop, uint8_t *out, size_t length, int64_t readyNs)
+{
+    size_t done = 0;
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    LoopTrim(loop, NowNs());
+    while (done < length && !loop.chunks.empty() && loop.chunks.front().readyNs <= readyNs) {
+        struct LoopChunk &chunk = loop.chunks.front();
+        size_t count = std::min(length - done, chunk.data.size() - chunk.offset);
+        (void)memcpy(out + done, chunk.data.data() + chunk.offset, count);
+        chunk.offset += count;
+        done += count;
+        loop.bytes -= count;
+        if (chunk.offset == chunk.data.size()) {
+            loop.chunks.pop_front();
+        }
+    }
+    return done;
+}
+
+void LoopClear(struct Loop &loop)
+{
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    loop.chunks.clear();
+    loop.bytes = 0;
+}
+
+/* only 16-bit streams are scaled; the other widths are looped unchanged unless muted. A volume change glides
+ * linearly across the period like a device mixer does, instead of stepping at the period boundary */
+void ApplyVolume(std::vector<uint8_t> &data, const struct AudioSampleAttributes &attrs, bool mute, float from,
+    float to)
+{
+    if (mute) {
+        std::fill(data.begin(), data.end(), attrs.format == AUDIO_FORMAT_PCM_8_BIT ? 0x80 : 0);
+        return;
+    }
+    if (attrs.format != AUDIO_FORMAT_PCM_16_BIT || (from >= 1.0f && to >= 1.0f) || attrs.channelCount == 0) {
+        return;
+    }
+    int16_t *samples = reinterpret_cast<int16_t *>(data.data());
+    size_t frames = data.size() / sizeof(int16_t) / attrs.channelCount;
+    float step = frames == 0 ? 0 : (to - from) / frames;
+    for (size_t frame = 0; frame < frames; frame++) {
+        float volume = from + step * (frame + 1);
+        for (uint32_t channel = 0; channel < attrs.channelCount; channel++) {
+            int16_t &sample = samples[frame * attrs.channelCount + channel];
+            sample = static_cast<int16_t>(sample * volume);
+        }
+    }
+}
+
+template<typename T>
+struct LoopbackStream *StreamOf(AudioHandle handle)
+{
+    return handle == nullptr ? nullptr : &reinterpret_cast<T *>(handle)->stream;
+}
+
+void StreamInit(struct LoopbackStream &stream, const struct AudioDeviceDescriptor &desc,
+    const struct AudioSampleAttributes &attrs, struct Loop *loop)
+{
+    stream.attrs = attrs;
+    stream.desc = desc;
+    stream.scene = {};
+    stream.clock = {};
+    stream.mute = false;
+    stream.volume = 1.0f;
+    stream.appliedVolume = 1.0f;
+    stream.gain = 1.0f;
+    stream.mmapAddress = nullptr;
+    stream.mmapLength = 0;
+    stream.loop = loop;
+}
+
+void StreamRelease(struct LoopbackStream &stream)
+{
+    if (stream.mmapAddress != nullptr) {
+        (void)munmap(stream.mmapAddress, stream.mmapLength);
+        stream.mmapAddress = nullptr;
+    }
+}
+
+template<typename T>
+int32_t LoopStart(AudioHandle handle)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->clock.started) {
+        return T::BUSY;
+    }
+    stream->clock = {};
+    stream->clock.started = true;
+    stream->clock.startNs = NowNs();
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopStop(AudioHandle handle)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (!stream->clock.started) {
+        return AUDIO_HAL_ERR_NOT_SUPPORT;
+    }
+    stream->clock.started = false;
+    stream->clock.paused = false;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopPause(AudioHandle handle)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (!stream->clock.started) {
+        return AUDIO_HAL_ERR_INTERNAL;
+    }
+    if (stream->clock.paused) {
+        return AUDIO_HAL_ERR_NOT_SUPPORT;
+    }
+    stream->clock.paused = true;
+    stream->clock.pausedAtNs = NowNs();
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopResume(AudioHandle handle)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (!stream->clock.started || !stream->clock.paused) {
+        return AUDIO_HAL_ERR_NOT_SUPPORT;
+    }
+    stream->clock.startNs += NowNs() - stream->clock.pausedAtNs;
+    stream->clock.paused = false;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopFlush(AudioHandle handle)
+{
+    return handle == nullptr ? AUDIO_HAL_ERR_INVALID_PARAM : AUDIO_HAL_ERR_NOT_SUPPORT;
+}
+
+template<typename T>
+int32_t LoopStandby(AudioHandle handle)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->clock.started = false;
+    stream->clock.paused = false;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopDump(AudioHandle handle, int32_t range, int32_t fd)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (fd >= 0) {
+        (void)dprintf(fd, "loopback range=%d rate=%u channels=%u frames=%llu\n", range, stream->attrs.sampleRate,
+            stream->attrs.channelCount, static_cast<unsigned long long>(stream->clock.frames));
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetFrameSize(AudioHandle handle, uint64_t *size)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || size == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *size = FrameBytes(stream->attrs);
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetFrameCount(AudioHandle handle, uint64_t *count)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || count == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *count = stream->clock.frames;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSetSampleAttributes(AudioHandle handle, const struct AudioSampleAttributes *attrs)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || attrs == nullptr || !AttrsSupported(*attrs)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->attrs = *attrs;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetSampleAttributes(AudioHandle handle, struct AudioSampleAttributes *attrs)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || attrs == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *attrs = stream->attrs;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetCurrentChannelId(AudioHandle handle, uint32_t *channelId)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || channelId == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *channelId = stream->attrs.channelCount;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSetExtraParams(AudioHandle handle, const char *keyValueList)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || keyValueList == nullptr || strlen(keyValueList) >= EXTRA_PARAMS_LENGTH) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->extraParams = keyValueList;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetExtraParams(AudioHandle handle, char *keyValueList, int32_t listLenth)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || keyValueList == nullptr || listLenth <= 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (stream->extraParams.size() >= static_cast<size_t>(listLenth)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    (void)memcpy(keyValueList, stream->extraParams.c_str(), stream->extraParams.size() + 1);
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* anonymous memory stands in for the shared DMA buffer; its content is not looped */
+template<typename T>
+int32_t LoopReqMmapBuffer(AudioHandle handle, int32_t reqSize, struct AudioMmapBufferDescripter *desc)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || desc == nullptr || reqSize <= 0) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    uint32_t frameBytes = FrameBytes(stream->attrs);
+    StreamRelease(*stream);
+    void *address = mmap(nullptr, reqSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address == MAP_FAILED) {
+        return AUDIO_HAL_ERR_MALLOC_FAIL;
+    }
+    stream->mmapAddress = address;
+    stream->mmapLength = static_cast<size_t>(reqSize);
+    desc->memoryAddress = address;
+    desc->memoryFd = -1;
+    desc->totalBufferFrames = reqSize / static_cast<int32_t>(frameBytes);
+    int32_t periodFrames = static_cast<int32_t>(stream->attrs.period / frameBytes);
+    desc->transferFrameSize = std::min(desc->totalBufferFrames, periodFrames);
+    desc->isShareable = 0;
+    desc->offset = 0;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetMmapPosition(AudioHandle handle, uint64_t *frames, struct AudioTimeStamp *time)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || frames == nullptr || time == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    int64_t nowNs = NowNs();
+    *frames = ClockFrames(stream->clock, stream->attrs.sampleRate, nowNs);
+    time->tvSec = nowNs / NSEC_PER_SEC;
+    time->tvNSec = nowNs % NSEC_PER_SEC;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopCheckSceneCapability(AudioHandle handle, const struct AudioSceneDescriptor *scene, bool *supported)
+{
+    if (handle == nullptr || scene == nullptr || supported == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *supported = scene->scene.id <= static_cast<uint32_t>(AUDIO_IN_CALL);
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSelectScene(AudioHandle handle, const struct AudioSceneDescriptor *scene)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || scene == nullptr || scene->scene.id > static_cast<uint32_t>(AUDIO_IN_CALL)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->scene = *scene;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSetMute(AudioHandle handle, bool mute)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->mute = mute;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetMute(AudioHandle handle, bool *mute)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || mute == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *mute = stream->mute;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSetVolume(AudioHandle handle, float volume)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || volume < 0.0f || volume > 1.0f) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->volume = volume;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetVolume(AudioHandle handle, float *volume)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || volume == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *volume = stream->volume;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetGainThreshold(AudioHandle handle, float *min, float *max)
+{
+    if (handle == nullptr || min == nullptr || max == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *min = GAIN_MIN;
+    *max = GAIN_MAX;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopSetGain(AudioHandle handle, float gain)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || gain < GAIN_MIN || gain > GAIN_MAX) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->gain = gain;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T>
+int32_t LoopGetGain(AudioHandle handle, float *gain)
+{
+    struct LoopbackStream *stream = StreamOf<T>(handle);
+    if (stream == nullptr || gain == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    *gain = stream->gain;
+    return AUDIO_HAL_SUCCESS;
+}
+
+template<typename T, typename Handle>
+void BindCommon(Handle &handle)
+{
+    handle.control.Start = LoopStart<T>;
+    handle.control.Stop = LoopStop<T>;
+    handle.control.Pause = LoopPause<T>;
+    handle.control.Resume = LoopResume<T>;
+    handle.control.Flush = LoopFlush<T>;
+    handle.control.TurnStandbyMode = LoopStandby<T>;
+    handle.control.AudioDevDump = LoopDump<T>;
+    handle.attr.GetFrameSize = LoopGetFrameSize<T>;
+    handle.attr.GetFrameCount = LoopGetFrameCount<T>;
+    handle.attr.SetSampleAttributes = LoopSetSampleAttributes<T>;
+    handle.attr.GetSampleAttributes = LoopGetSampleAttributes<T>;
+    handle.attr.GetCurrentChannelId = LoopGetCurrentChannelId<T>;
+    handle.attr.SetExtraParams = LoopSetExtraParams<T>;
+    handle.attr.GetExtraParams = LoopGetExtraParams<T>;
+    handle.attr.ReqMmapBuffer = LoopReqMmapBuffer<T>;
+    handle.attr.GetMmapPosition = LoopGetMmapPosition<T>;
+    handle.scene.CheckSceneCapability = LoopCheckSceneCapability<T>;
+    handle.scene.SelectScene = LoopSelectScene<T>;
+    handle.volume.SetMute = LoopSetMute<T>;
+    handle.volume.GetMute = LoopGetMute<T>;
+    handle.volume.SetVolume = LoopSetVolume<T>;
+    handle.volume.GetVolume = LoopGetVolume<T>;
+    handle.volume.GetGainThreshold = LoopGetGainThreshold<T>;
+    handle.volume.SetGain = LoopSetGain<T>;
+    handle.volume.GetGain = LoopGetGain<T>;
+}
+
+int32_t RenderGetLatency(struct AudioRender *render, uint32_t *ms)
+{
+    if (render == nullptr || ms == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *ms = (g_config.latencyUs.load() + LOOPBACK_BUFFER_NS / NSEC_PER_USEC) / USEC_PER_MSEC;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t RenderFrame(struct AudioRender *render, const void *frame, uint64_t requestBytes, uint64_t *replyBytes)
+{
+    if (render == nullptr || frame == nullptr || replyBytes == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    struct LoopbackStream &stream = self->stream;
+    if (InjectFailure()) {
+        return FRAME_FAILURE;
+    }
+    bool paced = g_config.paced.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(stream.mutex);
+    uint32_t frameBytes = FrameBytes(stream.attrs);
+    uint64_t frames = frameBytes == 0 ? 0 : requestBytes / frameBytes;
+    if (!stream.clock.started) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    if (stream.clock.paused || frames == 0) {
+        return AUDIO_HAL_ERR_INTERNAL;
+    }
+    const uint8_t *bytes = static_cast<const uint8_t *>(frame);
+    std::vector<uint8_t> data(bytes, bytes + frames * frameBytes);
+    ApplyVolume(data, stream.attrs, stream.mute, stream.appliedVolume, stream.volume);
+    stream.appliedVolume = stream.volume;
+    int64_t nowNs = NowNs();
+    int64_t playNs = stream.clock.startNs + FramesToNs(stream.clock.frames, stream.attrs.sampleRate);
+    if (!paced || playNs < nowNs) {
+        /* underrun: the device played out everything it had and restarts from the next period */
+        stream.clock.startNs += nowNs - playNs;
+        playNs = nowNs;
+    }
+    stream.clock.frames += frames;
+    /* RegCallback may swap these at any time; the pair is taken together and called without the lock */
+    RenderCallback callback = self->callback;
+    void *cookie = self->cookie;
+    lock.unlock();
+
+    if (paced) {
+        SleepUntil(playNs - LOOPBACK_BUFFER_NS);
+    }
+    uint32_t jitterUs = g_config.jitterUs.load(std::memory_order_relaxed);
+    int64_t delayUs = g_config.latencyUs.load(std::memory_order_relaxed) + (jitterUs == 0 ? 0 : RandomBelow(jitterUs));
+    *replyBytes = data.size();
+    g_stats.renderedBytes.fetch_add(data.size(), std::memory_order_relaxed);
+    LoopPush(*stream.loop, playNs + delayUs * NSEC_PER_USEC, std::move(data));
+    if (callback != nullptr) {
+        (void)callback(AUDIO_NONBLOCK_WRITE_COMPELETED, nullptr, cookie);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* the timestamp is when the reported frame was played, so frames and time advance together */
+int32_t RenderGetPosition(struct AudioRender *render, uint64_t *frames, struct AudioTimeStamp *time)
+{
+    if (render == nullptr || frames == nullptr || time == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackStream &stream = reinterpret_cast<struct LoopbackRender *>(render)->stream;
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    uint64_t played = ClockFrames(stream.clock, stream.attrs.sampleRate, NowNs());
+    *frames = std::min(played, stream.clock.frames);
+    int64_t stampNs = stream.clock.startNs + FramesToNs(*frames, stream.attrs.sampleRate);
+    time->tvSec = stampNs / NSEC_PER_SEC;
+    time->tvNSec = stampNs % NSEC_PER_SEC;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t RenderSetSpeed(struct AudioRender *render, float speed)
+{
+    (void)speed;
+    return render == nullptr ? AUDIO_HAL_ERR_INVALID_PARAM : AUDIO_HAL_ERR_NOT_SUPPORT;
+}
+
+int32_t RenderGetSpeed(struct AudioRender *render, float *speed)
+{
+    return render == nullptr || speed == nullptr ? AUDIO_HAL_ERR_INVALID_PARAM : AUDIO_HAL_ERR_NOT_SUPPORT;
+}
+
+int32_t RenderSetChannelMode(struct AudioRender *render, enum AudioChannelMode mode)
+{
+    if (render == nullptr || static_cast<uint32_t>(mode) > static_cast<uint32_t>(AUDIO_CHANNEL_BOTH_MUTE)) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    std::lock_guard<std::mutex> lock(self->stream.mutex);
+    self->channelMode = mode;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t RenderGetChannelMode(struct AudioRender *render, enum AudioChannelMode *mode)
+{
+    if (render == nullptr || mode == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    std::lock_guard<std::mutex> lock(self->stream.mutex);
+    *mode = self->channelMode;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t RenderRegCallback(struct AudioRender *render, RenderCallback callback, void *cookie)
+{
+    if (render == nullptr || callback == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    std::lock_guard<std::mutex> lock(self->stream.mutex);
+    self->callback = callback;
+    self->cookie = cookie;
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* returns once the clock has played every frame handed over so far */
+int32_t RenderDrainBuffer(struct AudioRender *render, enum AudioDrainNotifyType *type)
+{
+    if (render == nullptr || type == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    int64_t drainedNs = 0;
+    RenderCallback callback = nullptr;
+    void *cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(self->stream.mutex);
+        if (!self->stream.clock.started || self->stream.clock.paused) {
+            return AUDIO_HAL_ERR_INTERNAL;
+        }
+        drainedNs = self->stream.clock.startNs + FramesToNs(self->stream.clock.frames, self->stream.attrs.sampleRate);
+        callback = self->callback;
+        cookie = self->cookie;
+    }
+    if (g_config.paced.load(std::memory_order_relaxed)) {
+        SleepUntil(drainedNs);
+    }
+    if (callback != nullptr) {
+        (void)callback(AUDIO_DRAIN_COMPELETED, nullptr, cookie);
+    }
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t CaptureFrame(struct AudioCapture *capture, void *frame, uint64_t requestBytes, uint64_t *replyBytes)
+{
+    if (capture == nullptr || frame == nullptr || replyBytes == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackStream &stream = reinterpret_cast<struct LoopbackCapture *>(capture)->stream;
+    if (InjectFailure()) {
+        return FRAME_FAILURE;
+    }
+    bool paced = g_config.paced.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(stream.mutex);
+    uint32_t frameBytes = FrameBytes(stream.attrs);
+    uint64_t frames = frameBytes == 0 ? 0 : requestBytes / frameBytes;
+    if (!stream.clock.started) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    if (stream.clock.paused || frames == 0) {
+        return AUDIO_HAL_ERR_INTERNAL;
+    }
+    stream.clock.frames += frames;
+    int64_t nowNs = NowNs();
+    int64_t recordedNs = stream.clock.startNs + FramesToNs(stream.clock.frames, stream.attrs.sampleRate);
+    if (!paced || recordedNs < nowNs - LOOPBACK_BUFFER_NS) {
+        /* overrun: the periods the reader was too slow for are lost, the clock resumes at the current time */
+        stream.clock.startNs += nowNs - recordedNs;
+        recordedNs = nowNs;
+    }
+    bool mute = stream.mute;
+    uint8_t silence = stream.attrs.format == AUDIO_FORMAT_PCM_8_BIT ? 0x80 : 0;
+    lock.unlock();
+
+    if (paced) {
+        SleepUntil(recordedNs);
+    }
+    uint8_t *out = static_cast<uint8_t *>(frame);
+    size_t length = frames * frameBytes;
+    size_t pulled = LoopPull(*stream.loop, out, length, recordedNs);
+    g_stats.capturedBytes.fetch_add(pulled, std::memory_order_relaxed);
+    (void)memset(out + pulled, silence, length - pulled);
+    if (mute) {
+        (void)memset(out, silence, length);
+    }
+    *replyBytes = length;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t CaptureGetPosition(struct AudioCapture *capture, uint64_t *frames, struct AudioTimeStamp *time)
+{
+    if (capture == nullptr || frames == nullptr || time == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackStream &stream = reinterpret_cast<struct LoopbackCapture *>(capture)->stream;
+    std::lock_guard<std::mutex> lock(stream.mutex);
+    *frames = stream.clock.frames;
+    int64_t stampNs = stream.clock.startNs + FramesToNs(stream.clock.frames, stream.attrs.sampleRate);
+    time->tvSec = stampNs / NSEC_PER_SEC;
+    time->tvNSec = stampNs % NSEC_PER_SEC;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterInitAllPorts(struct AudioAdapter *adapter)
+{
+    return adapter == nullptr ? AUDIO_HAL_ERR_INVALID_PARAM : AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterCreateRender(struct AudioAdapter *adapter, const struct AudioDeviceDescriptor *desc,
+    const struct AudioSampleAttributes *attrs, struct AudioRender **render)
+{
+    if (adapter == nullptr || desc == nullptr || attrs == nullptr || render == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackAdapter *owner = reinterpret_cast<struct LoopbackAdapter *>(adapter);
+    if (!AttrsSupported(*attrs) || !DeviceSupported(*owner, *desc, PORT_OUT)) {
+        return AUDIO_HAL_ERR_INTERNAL;
+    }
+    struct LoopbackRender *self = new (std::nothrow) LoopbackRender();
+    if (self == nullptr) {
+        return AUDIO_HAL_ERR_MALLOC_FAIL;
+    }
+    StreamInit(self->stream, *desc, *attrs, owner->loop);
+    self->channelMode = AUDIO_CHANNEL_NORMAL;
+    BindCommon<struct LoopbackRender>(self->render);
+    self->render.GetLatency = RenderGetLatency;
+    self->render.RenderFrame = RenderFrame;
+    self->render.GetRenderPosition = RenderGetPosition;
+    self->render.SetRenderSpeed = RenderSetSpeed;
+    self->render.GetRenderSpeed = RenderGetSpeed;
+    self->render.SetChannelMode = RenderSetChannelMode;
+    self->render.GetChannelMode = RenderGetChannelMode;
+    self->render.RegCallback = RenderRegCallback;
+    self->render.DrainBuffer = RenderDrainBuffer;
+    *render = &self->render;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterDestroyRender(struct AudioAdapter *adapter, struct AudioRender *render)
+{
+    if (adapter == nullptr || render == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackRender *self = reinterpret_cast<struct LoopbackRender *>(render);
+    StreamRelease(self->stream);
+    delete self;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterCreateCapture(struct AudioAdapter *adapter, const struct AudioDeviceDescriptor *desc,
+    const struct AudioSampleAttributes *attrs, struct AudioCapture **capture)
+{
+    if (adapter == nullptr || desc == nullptr || attrs == nullptr || capture == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackAdapter *owner = reinterpret_cast<struct LoopbackAdapter *>(adapter);
+    if (!AttrsSupported(*attrs) || !DeviceSupported(*owner, *desc, PORT_IN) || owner->capturing.exchange(true)) {
+        return AUDIO_HAL_ERR_INTERNAL;
+    }
+    struct LoopbackCapture *self = new (std::nothrow) LoopbackCapture();
+    if (self == nullptr) {
+        owner->capturing = false;
+        return AUDIO_HAL_ERR_MALLOC_FAIL;
+    }
+    StreamInit(self->stream, *desc, *attrs, owner->loop);
+    BindCommon<struct LoopbackCapture>(self->capture);
+    self->capture.CaptureFrame = CaptureFrame;
+    self->capture.GetCapturePosition = CaptureGetPosition;
+    *capture = &self->capture;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterDestroyCapture(struct AudioAdapter *adapter, struct AudioCapture *capture)
+{
+    if (adapter == nullptr || capture == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackCapture *self = reinterpret_cast<struct LoopbackCapture *>(capture);
+    StreamRelease(self->stream);
+    delete self;
+    reinterpret_cast<struct LoopbackAdapter *>(adapter)->capturing = false;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterGetPortCapability(struct AudioAdapter *adapter, const struct AudioPort *port,
+    struct AudioPortCapability *capability)
+{
+    if (adapter == nullptr || port == nullptr || capability == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *capability = {};
+    capability->deviceType = port->dir;
+    capability->deviceId = port->portId;
+    capability->hardwareMode = true;
+    capability->formatNum = sizeof(g_formats) / sizeof(g_formats[0]);
+    capability->formats = g_formats;
+    capability->channelCount = MAX_CHANNEL_COUNT;
+    capability->subPortsNum = sizeof(g_subPorts) / sizeof(g_subPorts[0]);
+    capability->subPorts = g_subPorts;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterSetPassthroughMode(struct AudioAdapter *adapter, const struct AudioPort *port,
+    enum AudioPortPassthroughMode mode)
+{
+    if (adapter == nullptr || port == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    if (port->dir != PORT_OUT || mode != PORT_PASSTHROUGH_LPCM) {
+        return AUDIO_HAL_ERR_NOT_SUPPORT;
+    }
+    reinterpret_cast<struct LoopbackAdapter *>(adapter)->mode = mode;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t AdapterGetPassthroughMode(struct AudioAdapter *adapter, const struct AudioPort *port,
+    enum AudioPortPassthroughMode *mode)
+{
+    if (adapter == nullptr || port == nullptr || mode == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *mode = reinterpret_cast<struct LoopbackAdapter *>(adapter)->mode;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t ManagerGetAllAdapters(struct AudioManager *manager, struct AudioAdapterDescriptor **descs, int *size)
+{
+    if (manager == nullptr || descs == nullptr || size == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    *descs = g_descriptors;
+    *size = DESCRIPTOR_COUNT;
+    return AUDIO_HAL_SUCCESS;
+}
+
+int32_t ManagerLoadAdapter(struct AudioManager *manager, const struct AudioAdapterDescriptor *desc,
+    struct AudioAdapter **adapter)
+{
+    if (manager == nullptr || desc == nullptr || desc->adapterName == nullptr || adapter == nullptr) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    int index = 0;
+    while (index < DESCRIPTOR_COUNT && strcmp(g_descriptors[index].adapterName, desc->adapterName) != 0) {
+        index++;
+    }
+    if (index == DESCRIPTOR_COUNT) {
+        return AUDIO_HAL_ERR_INVALID_PARAM;
+    }
+    struct LoopbackAdapter *self = new (std::nothrow) LoopbackAdapter();
+    if (self == nullptr) {
+        return AUDIO_HAL_ERR_MALLOC_FAIL;
+    }
+    self->descriptor = &g_descriptors[index];
+    self->loop = &g_loops[index];
+    self->mode = PORT_PASSTHROUGH_LPCM;
+    self->adapter.InitAllPorts = AdapterInitAllPorts;
+    self->adapter.CreateRender = AdapterCreateRender;
+    self->adapter.DestroyRender = AdapterDestroyRender;
+    self->adapter.CreateCapture = AdapterCreateCapture;
+    self->adapter.DestroyCapture = AdapterDestroyCapture;
+    self->adapter.GetPortCapability = AdapterGetPortCapability;
+    self->adapter.SetPassthroughMode = AdapterSetPassthroughMode;
+    self->adapter.GetPassthroughMode = AdapterGetPassthroughMode;
+    *adapter = &self->adapter;
+    return AUDIO_HAL_SUCCESS;
+}
+
+/* whatever is still queued on the loop goes with the last adapter, so a new test starts from silence */
+void ManagerUnloadAdapter(struct AudioManager *manager, struct AudioAdapter *adapter)
+{
+    if (manager == nullptr || adapter == nullptr) {
+        return;
+    }
+    struct LoopbackAdapter *self = reinterpret_cast<struct LoopbackAdapter *>(adapter);
+    LoopClear(*self->loop);
+    delete self;
+}
+
+void ManagerInit()
+{
+    g_config.latencyUs = ReadEnv(AUDIO_LOOPBACK_LATENCY_ENV, 0);
+    g_config.jitterUs = ReadEnv(AUDIO_LOOPBACK_JITTER_ENV, 0);
+    g_config.failPermille = std::min(ReadEnv(AUDIO_LOOPBACK_FAIL_ENV, 0), PERMILLE);
+    g_config.paced = ReadEnv(AUDIO_LOOPBACK_UNPACED_ENV, 0) == 0;
+    g_manager.GetAllAdapters = ManagerGetAllAdapters;
+    g_manager.LoadAdapter = ManagerLoadAdapter;
+    g_manager.UnloadAdapter = ManagerUnloadAdapter;
+}
+}
+}
+}
+
+using namespace HMOS::Audio;
+
+struct AudioManager *GetAudioManagerFuncs(void)
+{
+    std::call_once(g_managerOnce, ManagerInit);
+    return &g_manager;
+}
+
+struct AudioManager *GetAudioProxyManagerFuncs(void)
+{
+    return GetAudioManagerFuncs();
+}
+
+void AudioLoopbackSetConfig(const struct AudioLoopbackConfig *config)
+{
+    if (config == nullptr) {
+        return;
+    }
+    std::call_once(g_managerOnce, ManagerInit);
+    g_config.latencyUs = config->latencyUs;
+    g_config.jitterUs = config->jitterUs;
+    g_config.failPermille = std::min(config->failPermille, PERMILLE);
+    g_config.paced = config->paced;
+}
+
+void AudioLoopbackGetConfig(struct AudioLoopbackConfig *config)
+{
+    if (config == nullptr) {
+        return;
+    }
+    std::call_once(g_managerOnce, ManagerInit);
+    config->latencyUs = g_config.latencyUs;
+    config->jitterUs = g_config.jitterUs;
+    config->failPermille = g_config.failPermille;
+    config->paced = g_config.paced;
+}
+
+void AudioLoopbackGetStats(struct AudioLoopbackStats *stats)
+{
+    if (stats == nullptr) {
+        return;
+    }
+    stats->renderedBytes = g_stats.renderedBytes;
+    stats->capturedBytes = g_stats.capturedBytes;
+    stats->droppedBytes = g_stats.droppedBytes;
+    stats->injectedFailures = g_stats.injectedFailures;
+}
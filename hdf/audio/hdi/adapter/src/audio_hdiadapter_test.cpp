@@ -48,76 +48,18 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
 };
 
 TestAudioManager *(*AudioHdiAdapterTest::GetAudioManager)() = nullptr;
-void *AudioHdiAdapterTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiAdapterTest::SdkInit)() = nullptr;
-    void (*AudioHdiAdapterTest::SdkExit)() = nullptr;
-    void *AudioHdiAdapterTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiAdapterTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
-    if (GetAudioManager == nullptr) {
-        return;
-    }
+    GetAudioManager = AudioLoaderGetManagerFunc();
 }
 
 void AudioHdiAdapterTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
-    if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
-    }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiAdapterTest::SetUp(void) {}
@@ -394,6 +336,67 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_LoadAdapter_0007, Function | MediumT
 }
 #endif
 /**
+* @tc.name  Test GetLoadAdapter reuses a loaded adapter for both port directions.
+* @tc.number  SUB_Audio_HDI_LoadAdapter_0008
+* @tc.desc  Test GetLoadAdapter, and check the second load hands back the adapter already loaded.
+*/
+HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_LoadAdapter_0008, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioPort* renderPort = nullptr;
+    struct AudioPort* capturePort = nullptr;
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioAdapter *adapterReuse = nullptr;
+    ASSERT_NE(nullptr, GetAudioManager);
+    TestAudioManager* manager = GetAudioManager();
+
+    ret = GetLoadAdapter(manager, PORT_OUT, ADAPTER_NAME, &adapter, renderPort);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ASSERT_NE(nullptr, adapter);
+    ret = GetLoadAdapter(manager, PORT_IN, ADAPTER_NAME, &adapterReuse, capturePort);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    EXPECT_EQ(adapter, adapterReuse);
+    ASSERT_NE(nullptr, capturePort);
+    EXPECT_EQ(PORT_IN, capturePort->dir);
+
+    ReleaseLoadAdapter(manager, adapterReuse);
+    ReleaseLoadAdapter(manager, adapter);
+}
+/**
+* @tc.name  Test ReleaseLoadAdapter unloads a shared adapter once its last reference is released.
+* @tc.number  SUB_Audio_HDI_LoadAdapter_0009
+* @tc.desc  Test ReleaseLoadAdapter, and check the reference counts drop to zero after both releases.
+*/
+HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_LoadAdapter_0009, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    uint32_t adapters = 0;
+    uint32_t references = 0;
+    struct AudioPort* renderPort = nullptr;
+    struct AudioPort* capturePort = nullptr;
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioAdapter *adapterReuse = nullptr;
+    ASSERT_NE(nullptr, GetAudioManager);
+    TestAudioManager* manager = GetAudioManager();
+
+    ret = GetLoadAdapter(manager, PORT_OUT, ADAPTER_NAME, &adapter, renderPort);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = GetLoadAdapter(manager, PORT_IN, ADAPTER_NAME, &adapterReuse, capturePort);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    AdapterCacheCounts(manager, adapters, references);
+    EXPECT_EQ(1U, adapters);
+    EXPECT_EQ(2U, references);
+
+    ReleaseLoadAdapter(manager, adapterReuse);
+    AdapterCacheCounts(manager, adapters, references);
+    EXPECT_EQ(1U, adapters);
+    EXPECT_EQ(1U, references);
+    ReleaseLoadAdapter(manager, adapter);
+    AdapterCacheCounts(manager, adapters, references);
+    EXPECT_EQ(0U, adapters);
+    EXPECT_EQ(0U, references);
+}
+/**
 * @tc.name  Test AudioAdapterInitAllPorts API via legal input.
 * @tc.number  SUB_Audio_HDI_AdapterInitAllPorts_0001
 * @tc.desc  Test the AudioAdapterInitAllPorts API, and check if 0 is returned when then ports are initialized successfully.                   
@@ -411,7 +414,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterInitAllPorts_0001, Function |
     ASSERT_NE(nullptr, adapter);
     ret = adapter->InitAllPorts(adapter);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -435,7 +438,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterInitAllPorts_0002, Function |
     ASSERT_NE(nullptr, adapter);
     ret2 = GetLoadAdapter(manager, PORT_OUT, ADAPTER_NAME_OUT, &adapter1, renderPortUsb);
     if (ret2 < 0 || adapter1 == nullptr) {
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret2);
     }
     ret = adapter->InitAllPorts(adapter);
@@ -444,8 +447,8 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterInitAllPorts_0002, Function |
     ret2 = adapter1->InitAllPorts(adapter1);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret2);
 
-    manager->UnloadAdapter(manager, adapter);
-    manager->UnloadAdapter(manager, adapter1);
+    ReleaseLoadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter1);
 }
 
 /**
@@ -467,7 +470,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterInitAllPorts_0003, Function |
     ASSERT_NE(nullptr, adapter);
     ret = adapter->InitAllPorts(adapterNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -491,17 +494,17 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPortCapability_0001, Funct
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = adapter->GetPortCapability(adapter, audioPort, &capability);
     if (ret < 0 || capability.formats == nullptr || capability.subPorts == nullptr) {
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_NE(AUDIO_HAL_SUCCESS, ret);
         ASSERT_NE(nullptr, capability.formats);
         ASSERT_NE(nullptr, capability.subPorts);
     }
     if (capability.subPorts->desc == nullptr) {
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_NE(nullptr, capability.subPorts->desc);
     }
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -526,7 +529,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPortCapability_0002, Funct
     ret = adapter->GetPortCapability(adapter, audioPort, &capability);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioAdapterGetPortCapability API, when the parameter adapter is empty.
@@ -550,7 +553,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPortCapability_0004, Funct
     ret = adapter->GetPortCapability(adapterNull, audioPort, &capability);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -579,7 +582,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPortCapability_0005, Funct
 
     ret = adapter->GetPortCapability(adapter, &audioPortError, &capability);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -604,7 +607,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPortCapability_0006, Funct
     ret = adapter->GetPortCapability(adapter, audioPort, capabilityNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -632,7 +635,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterSetPassthroughMode_0001, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(PORT_PASSTHROUGH_LPCM, modeLpcm);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -656,7 +659,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterSetPassthroughMode_0002, Func
     ret = adapter->SetPassthroughMode(adapter, audioPort, PORT_PASSTHROUGH_LPCM);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -678,7 +681,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterSetPassthroughMode_0003, Func
     ASSERT_NE(nullptr, adapter);
     ret = adapter->SetPassthroughMode(adapterNull, audioPort, PORT_PASSTHROUGH_LPCM);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -706,7 +709,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterSetPassthroughMode_0004, Func
 
     ret = adapter->SetPassthroughMode(adapter, &audioPortError, mode);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -730,7 +733,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterSetPassthroughMode_0005, Func
     ret = adapter->SetPassthroughMode(adapter, audioPort, PORT_PASSTHROUGH_RAW);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -760,7 +763,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPassthroughMode_0001, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(PORT_PASSTHROUGH_LPCM, mode);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -786,7 +789,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPassthroughMode_0002, Func
     ret = adapter->GetPassthroughMode(adapterNull, audioPort, &mode);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -814,7 +817,7 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPassthroughMode_0003, Func
 
     ret = adapter->GetPassthroughMode(adapter, &audioPortError, &mode);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -839,6 +842,6 @@ HWTEST_F(AudioHdiAdapterTest, SUB_Audio_HDI_AdapterGetPassthroughMode_0004, Func
     ret = adapter->GetPassthroughMode(adapter, audioPort, modeNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_benchmark_test.h
+ *
+ * @brief Declares the stream configurations the latency benchmarks sweep.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef AUDIO_HDI_BENCHMARK_TEST_H
+#define AUDIO_HDI_BENCHMARK_TEST_H
+
+#include <cstdint>
+#include "audio_types.h"
+
+namespace HMOS {
+namespace Audio {
+const enum AudioFormat BENCHMARK_FORMATS[] = { AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_24_BIT };
+const uint32_t BENCHMARK_CHANNELS[] = { 1, 2 };
+const uint32_t BENCHMARK_SAMPLE_RATES[] = { 8000, 16000, 44100, 48000 };
+const int BENCHMARK_LABEL_LENGTH = 64;
+}
+}
+#endif // AUDIO_HDI_BENCHMARK_TEST_H
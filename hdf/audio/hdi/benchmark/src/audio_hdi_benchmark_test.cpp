@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_benchmark_test.cpp
+ *
+ * @brief Measures the latency of the audio render and capture data paths.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <memory>
+#include "audio_hdi_common.h"
+#include "audio_hdi_perf.h"
+#include "audio_hdi_benchmark_test.h"
+
+using namespace std;
+using namespace testing::ext;
+using namespace HMOS::Audio;
+
+namespace {
+const uint64_t FILESIZE = 1024;
+
+class AudioHdiBenchmarkTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+    static TestAudioManager *(*GetAudioManager)();
+};
+
+using THREAD_FUNC = void *(*)(void *);
+
+TestAudioManager *(*AudioHdiBenchmarkTest::GetAudioManager)() = nullptr;
+
+void AudioHdiBenchmarkTest::SetUpTestCase(void)
+{
+    GetAudioManager = AudioLoaderGetManagerFunc();
+}
+
+void AudioHdiBenchmarkTest::TearDownTestCase(void)
+{
+    GetAudioManager = nullptr;
+}
+
+void AudioHdiBenchmarkTest::SetUp(void) {}
+
+void AudioHdiBenchmarkTest::TearDown(void) {}
+
+/**
+* @tc.name  Test RenderFrame latency across formats, channel counts and sample rates
+* @tc.number  SUB_Audio_HDI_AudioRenderFrameLatency_0001
+* @tc.desc  Records per-call RenderFrame latency and prints p50/p99/p99.9 and jitter for each combination
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioRenderFrameLatency_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    char label[BENCHMARK_LABEL_LENGTH] = {0};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER
+    };
+    unique_ptr<struct AudioLatencyHistogram> histogram = make_unique<struct AudioLatencyHistogram>();
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    for (enum AudioFormat format : BENCHMARK_FORMATS) {
+        for (uint32_t channelCount : BENCHMARK_CHANNELS) {
+            for (uint32_t sampleRate : BENCHMARK_SAMPLE_RATES) {
+                InitAttrsUpdate(audiopara.attrs, format, channelCount, sampleRate);
+                ret = audiopara.render->attr.SetSampleAttributes(audiopara.render, &(audiopara.attrs));
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                ret = audiopara.render->control.Start((AudioHandle)(audiopara.render));
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                LatencyHistogramInit(*histogram);
+                ret = RenderFrameLatency(audiopara, BENCHMARK_FRAME_COUNT, *histogram);
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                EXPECT_EQ(BENCHMARK_FRAME_COUNT, histogram->count);
+                (void)snprintf(label, sizeof(label), "render %ubit %uch %uHz", PcmFormatToBits(format),
+                    channelCount, sampleRate);
+                LatencyHistogramPrint(label, *histogram);
+                audiopara.render->control.Stop((AudioHandle)(audiopara.render));
+            }
+        }
+    }
+
+    audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+}
+/**
+* @tc.name  Test CaptureFrame latency across formats, channel counts and sample rates
+* @tc.number  SUB_Audio_HDI_AudioCaptureFrameLatency_0001
+* @tc.desc  Records per-call CaptureFrame latency and prints p50/p99/p99.9 and jitter for each combination
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioCaptureFrameLatency_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    char label[BENCHMARK_LABEL_LENGTH] = {0};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC
+    };
+    unique_ptr<struct AudioLatencyHistogram> histogram = make_unique<struct AudioLatencyHistogram>();
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+    ret = AudioCreateCapture(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                             &audiopara.capture);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    for (enum AudioFormat format : BENCHMARK_FORMATS) {
+        for (uint32_t channelCount : BENCHMARK_CHANNELS) {
+            for (uint32_t sampleRate : BENCHMARK_SAMPLE_RATES) {
+                InitAttrsUpdate(audiopara.attrs, format, channelCount, sampleRate);
+                ret = audiopara.capture->attr.SetSampleAttributes(audiopara.capture, &(audiopara.attrs));
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                ret = audiopara.capture->control.Start((AudioHandle)(audiopara.capture));
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                LatencyHistogramInit(*histogram);
+                ret = CaptureFrameLatency(audiopara, BENCHMARK_FRAME_COUNT, *histogram);
+                EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+                EXPECT_EQ(BENCHMARK_FRAME_COUNT, histogram->count);
+                (void)snprintf(label, sizeof(label), "capture %ubit %uch %uHz", PcmFormatToBits(format),
+                    channelCount, sampleRate);
+                LatencyHistogramPrint(label, *histogram);
+                audiopara.capture->control.Stop((AudioHandle)(audiopara.capture));
+            }
+        }
+    }
+
+    audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+}
+/**
+* @tc.name  Test concurrent render and capture streams sharing the codec
+* @tc.number  SUB_Audio_HDI_AudioStress_0001
+* @tc.desc  Runs three renders across both output adapters and two captures together, prints throughput, xruns and
+*           per-stream latency, and returns 0 if every stream keeps running for the whole window
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioStress_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    const uint32_t renderCount = 3;
+    const uint32_t captureCount = 2;
+    unique_ptr<struct AudioStressReport> report = make_unique<struct AudioStressReport>();
+    ASSERT_NE(GetAudioManager, nullptr);
+    TestAudioManager *manager = GetAudioManager();
+    ASSERT_NE(manager, nullptr);
+
+    ret = AudioStressRun(manager, renderCount, captureCount, STRESS_DURATION_MS, *report);
+    AudioStressPrint(*report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    for (uint32_t index = 0; index < report->streamCount; index++) {
+        EXPECT_GT(report->streams[index].bytes, INITIAL_VALUE);
+    }
+    EXPECT_GT(report->bytesPerSecond, 0);
+}
+/**
+* @tc.name  Test sustained throughput and position drift of the render MMAP path
+* @tc.number  SUB_Audio_HDI_AudioRenderMmapStream_0001
+* @tc.desc  Streams the low latency fixture through ReqMmapBuffer while polling GetMmapPosition, and returns 0 if the
+*           position reaches the end of the buffer
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioRenderMmapStream_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioMmapStreamStats stats = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER,
+        .path = LOW_LATENCY_AUDIO_FILE.c_str()
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    InitAttrs(audiopara.attrs);
+    audiopara.attrs.startThreshold = 0;
+    ret = audiopara.render->attr.SetSampleAttributes(audiopara.render, &(audiopara.attrs));
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    ret = PlayMmapStream(audiopara, stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    MmapStreamPrint("render mmap", stats);
+    EXPECT_GT(stats.frames, INITIAL_VALUE);
+    EXPECT_GT(stats.bytesPerSecond, 0);
+
+    audiopara.render->control.Stop((AudioHandle)audiopara.render);
+    audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+}
+/**
+* @tc.name  Test sustained throughput and position drift of the capture MMAP path
+* @tc.number  SUB_Audio_HDI_AudioCaptureMmapStream_0001
+* @tc.desc  Fills the capture mapping through ReqMmapBuffer while polling GetMmapPosition, and returns 0 if the
+*           position reaches the end of the buffer
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioCaptureMmapStream_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioMmapStreamStats stats = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC,
+        .path = AUDIO_LOW_LATENCY_CAPTURE_FILE.c_str()
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+    ret = AudioCreateCapture(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                             &audiopara.capture);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    ret = RecordMmapStream(audiopara, stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    MmapStreamPrint("capture mmap", stats);
+    EXPECT_GT(stats.frames, INITIAL_VALUE);
+    EXPECT_GT(stats.bytesPerSecond, 0);
+
+    audiopara.capture->control.Stop((AudioHandle)audiopara.capture);
+    audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+}
+/**
+* @tc.name  Test submit-to-completion latency of RenderFrame driven by the RegCallback completion path
+* @tc.number  SUB_Audio_HDI_AudioRenderNonblockLatency_0001
+* @tc.desc  Keeps at most NONBLOCK_MAX_OUTSTANDING frames in flight, matches AUDIO_NONBLOCK_WRITE_COMPELETED events to
+*           submits and prints the latency percentiles; returns 0 if every frame was submitted
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioRenderNonblockLatency_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER
+    };
+    unique_ptr<struct AudioNonblockStats> stats = make_unique<struct AudioNonblockStats>();
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    InitAttrs(audiopara.attrs);
+    ret = audiopara.render->control.Start((AudioHandle)audiopara.render);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    ret = RenderNonblockLatency(audiopara, BENCHMARK_FRAME_COUNT, *stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    NonblockStatsPrint("render nonblock", *stats);
+    EXPECT_EQ(BENCHMARK_FRAME_COUNT, stats->submitted);
+    EXPECT_GE(stats->submitted, stats->completed);
+    EXPECT_EQ(stats->completed, stats->histogram.count);
+
+    audiopara.render->control.Stop((AudioHandle)audiopara.render);
+    audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
+}
+/**
+* @tc.name  Test the accuracy of the GetRenderPosition clock during playback
+* @tc.number  SUB_Audio_HDI_AudioRenderPositionClock_0001
+* @tc.desc  Samples GetRenderPosition while PlayAudioFile runs, fits frames against the reported timestamp and
+*           prints drift, jitter and staleness; returns 0 if the position never goes backwards
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioRenderPositionClock_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioClockReport report = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER,
+        .path = AUDIO_FILE.c_str()
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayAudioFile, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.render != nullptr) {
+        ret = RenderPositionAnalyze(audiopara.render, POSITION_ANALYZE_MS, report);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        ClockReportPrint("render position", report);
+        EXPECT_EQ(INITIAL_VALUE, report.regressions);
+        EXPECT_LT(INITIAL_VALUE, report.samples);
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+/**
+* @tc.name  Test the accuracy of the GetCapturePosition clock during recording
+* @tc.number  SUB_Audio_HDI_AudioCapturePositionClock_0001
+* @tc.desc  Samples GetCapturePosition while RecordAudio runs, fits frames against the reported timestamp and
+*           prints drift, jitter and staleness; returns 0 if the position never goes backwards
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioCapturePositionClock_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioClockReport report = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC,
+        .path = AUDIO_CAPTURE_FILE.c_str(), .fileSize = FILESIZE
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordAudio, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.capture != nullptr) {
+        ret = CapturePositionAnalyze(audiopara.capture, POSITION_ANALYZE_MS, report);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        ClockReportPrint("capture position", report);
+        EXPECT_EQ(INITIAL_VALUE, report.regressions);
+        EXPECT_LT(INITIAL_VALUE, report.samples);
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+/**
+* @tc.name  Test the cost of switching the render scene between pins during playback
+* @tc.number  SUB_Audio_HDI_AudioRenderSceneSwitch_0001
+* @tc.desc  Switches SelectScene between speaker and headset while PlayAudioFile runs, timing each call and the
+*           longest GetRenderPosition stall after it; returns 0 if every switch succeeds and the position never
+*           goes backwards
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioRenderSceneSwitch_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioSceneReport report = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER,
+        .path = AUDIO_FILE.c_str()
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayAudioFile, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.render != nullptr) {
+        ret = RenderSceneSwitchRun(audiopara.render, SCENE_RENDER_PINS,
+            sizeof(SCENE_RENDER_PINS) / sizeof(SCENE_RENDER_PINS[0]), SCENE_SWITCH_COUNT, report);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        SceneReportPrint("render scene", report);
+        EXPECT_EQ(INITIAL_VALUE, report.regressions);
+        for (const struct AudioSceneSwitch &sceneSwitch : report.switches) {
+            EXPECT_EQ(AUDIO_HAL_SUCCESS, sceneSwitch.result);
+        }
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+/**
+* @tc.name  Test the cost of switching the capture scene between pins during recording
+* @tc.number  SUB_Audio_HDI_AudioCaptureSceneSwitch_0001
+* @tc.desc  Switches SelectScene between mic and headset mic while RecordAudio runs, timing each call and the
+*           longest GetCapturePosition stall after it; returns 0 if every switch succeeds and the position never
+*           goes backwards
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioCaptureSceneSwitch_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioSceneReport report = {};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC,
+        .path = AUDIO_CAPTURE_FILE.c_str(), .fileSize = FILESIZE
+    };
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordAudio, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.capture != nullptr) {
+        ret = CaptureSceneSwitchRun(audiopara.capture, SCENE_CAPTURE_PINS,
+            sizeof(SCENE_CAPTURE_PINS) / sizeof(SCENE_CAPTURE_PINS[0]), SCENE_SWITCH_COUNT, report);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        SceneReportPrint("capture scene", report);
+        EXPECT_EQ(INITIAL_VALUE, report.regressions);
+        for (const struct AudioSceneSwitch &sceneSwitch : report.switches) {
+            EXPECT_EQ(AUDIO_HAL_SUCCESS, sceneSwitch.result);
+        }
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+
+/**
+* @tc.name  Long-running render and capture soak
+* @tc.number  SUB_Audio_HDI_AudioSoak_0001
+* @tc.desc  Cycles render and capture streams for AUDIO_SOAK_DURATION_MS (60s by default) while sampling RSS, open
+*           fds and loaded adapters every second; returns 0 if both streams survive and no fd or adapter leaks
+*/
+HWTEST_F(AudioHdiBenchmarkTest, SUB_Audio_HDI_AudioSoak_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioSoakReport report = {};
+    ASSERT_NE(GetAudioManager, nullptr);
+    TestAudioManager *manager = GetAudioManager();
+    ASSERT_NE(manager, nullptr);
+
+    ret = AudioSoakRun(manager, SoakDurationMs(), report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    AudioSoakPrint(report);
+    ASSERT_LE(2u, report.samples.size());
+    const struct AudioSoakSample &first = report.samples.front();
+    const struct AudioSoakSample &last = report.samples.back();
+    EXPECT_LE(last.fds, first.fds + SOAK_FD_TOLERANCE);
+    EXPECT_EQ(first.adapterReferences, last.adapterReferences);
+    EXPECT_LT(INITIAL_VALUE, report.renderCycles);
+    EXPECT_LT(INITIAL_VALUE, report.captureCycles);
+}
+}
@@ -34,6 +34,7 @@
  */
 
 #include "audio_hdi_common.h"
+#include "audio_hdi_perf.h"
 #include "audio_hdicapture_attr_test.h"
 
 using namespace std;
@@ -48,79 +49,28 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
     int32_t AudioCaptureStart(const string path, struct AudioCapture *capture) const;
 };
 
 using THREAD_FUNC = void *(*)(void *);
 
 TestAudioManager *(*AudioHdiCaptureAttrTest::GetAudioManager)() = nullptr;
-void *AudioHdiCaptureAttrTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiCaptureAttrTest::SdkInit)() = nullptr;
-    void (*AudioHdiCaptureAttrTest::SdkExit)() = nullptr;
-    void *AudioHdiCaptureAttrTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiCaptureAttrTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
+    GetAudioManager = AudioLoaderGetManagerFunc();
     if (GetAudioManager == nullptr) {
         return;
     }
+    (void)AdapterCacheRetain(GetAudioManager(), true);
 }
 
 void AudioHdiCaptureAttrTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
     if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
+        AdapterCacheRelease(GetAudioManager());
     }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiCaptureAttrTest::SetUp(void) {}
@@ -178,7 +128,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -212,7 +162,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -246,7 +196,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -280,7 +230,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -314,7 +264,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -348,7 +298,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via setting the capture is empty .
@@ -374,7 +324,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -409,7 +359,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -444,7 +394,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -479,7 +429,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -514,7 +464,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via legal input.
@@ -549,7 +499,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via illegal input.
@@ -576,7 +526,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via illegal input.
@@ -613,7 +563,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via illegal input.
@@ -650,7 +600,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via illegal input.
@@ -682,7 +632,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSetSampleAttributes API via illegal input.
@@ -709,7 +659,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetSampleAttributes API via legal input.
@@ -745,7 +695,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureGetSampleAttributes_
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetSampleAttributes API via setting the capture is empty .
@@ -771,7 +721,41 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureGetSampleAttributes_
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
+}
+/**
+* @tc.name  Test AudioCaptureSetSampleAttributes across the legal format, channel, rate and period matrix
+* @tc.number  SUB_Audio_HDI_AudioCaptureSampleAttributesMatrix_0001
+* @tc.desc  Applies every combination to one capture, prints set/get and first-frame latency as CSV, and returns 0
+*           if each combination is accepted, read back unchanged and captures a frame
+*/
+HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_AudioCaptureSampleAttributesMatrix_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    std::vector<struct AudioAttrSweepCase> cases;
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC
+    };
+    ASSERT_NE(nullptr, GetAudioManager);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(nullptr, audiopara.manager);
+    ret = AudioCreateCapture(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                             &audiopara.capture);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    ret = CaptureAttrSweep(audiopara, ATTR_SWEEP_LEGAL, cases);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    AttrSweepPrintCsv("capture", cases);
+    EXPECT_EQ(ATTR_SWEEP_LEGAL.formatCount * ATTR_SWEEP_LEGAL.channelCount * ATTR_SWEEP_LEGAL.sampleRateCount *
+        ATTR_SWEEP_LEGAL.periodCount, cases.size());
+    for (const struct AudioAttrSweepCase &sweepCase : cases) {
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, sweepCase.result);
+        EXPECT_TRUE(sweepCase.matched);
+        EXPECT_LE(0, sweepCase.firstFrameNs);
+    }
+
+    audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameSize API via legal input
@@ -793,7 +777,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0001, Functi
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameSize API via setting the parameter handle is nullptr
@@ -816,7 +800,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0002, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameSize API via setting the parameter size is nullptr
@@ -838,7 +822,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0003, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameSize API via define format to different values
@@ -872,7 +856,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0004, Functi
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameSize API via define sampleRate to different values
@@ -906,7 +890,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0005, Functi
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameSize API via define channelCount to different values
@@ -940,7 +924,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0006, Functi
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameSize API via define sampleRate to different value
@@ -974,7 +958,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameSize_0007, Functi
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameCount API via legal input
@@ -997,7 +981,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0001, Funct
     EXPECT_EQ(count, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameCount API via legal input in the difference scene
@@ -1024,7 +1008,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0002, Funct
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameCount API via setting the parameter handle is nullptr
@@ -1047,7 +1031,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0003, Funct
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -1070,7 +1054,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0004, Funct
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameCount API via define channelCount to different value
@@ -1108,7 +1092,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0005, Funct
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameCount API via define format to different value
@@ -1146,7 +1130,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0006, Funct
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameCount API via define channelCount to different value
@@ -1184,7 +1168,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0007, Funct
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetFrameCount API via define format to different value
@@ -1222,7 +1206,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_hdi_CaptureGetFrameCount_0008, Funct
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetCurrentChannelId API via legal input
@@ -1246,7 +1230,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetCurrentChannelId_0001,
     EXPECT_EQ(channelIdValue, channelId);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test GetCurrentChannelId API via getting channelId to 1 and set channelCount to 1
@@ -1279,7 +1263,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetCurrentChannelId_0002,
     EXPECT_EQ(channelIdExp, channelId);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test GetCurrentChannelId API via CurrentChannelId is obtained after started
@@ -1306,7 +1290,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetCurrentChannelId_0003,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test GetCurrentChannelId API via setting the parameter capture is nullptr
@@ -1329,7 +1313,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetCurrentChannelId_0004,
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetCurrentChannelId API via setting the parameter channelId is nullptr
@@ -1351,7 +1335,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetCurrentChannelId_0005,
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 #if defined (AUDIO_ADM_SERVICE) || defined (AUDIO_ADM_SO) || defined (__LITEOS__)
 /**
@@ -1452,7 +1436,7 @@ attr-sampling-rate=48000";
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via setting keyvaluelist to a value outside the range
@@ -1474,7 +1458,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureSetExtraParams_0003, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via adding parameters to keyvaluelist
@@ -1497,7 +1481,7 @@ attr-para=abc";
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via setting ExtraParams When the key is the same and the value is
@@ -1530,7 +1514,7 @@ attr-sampling-rate=48000";
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via setting the parameter in keyvaluelist as an abnormal value
@@ -1564,7 +1548,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureSetExtraParams_0006, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via setting the parameter render is nullptr
@@ -1587,7 +1571,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureSetExtraParams_0007, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureSetExtraParams API via setting the format of ExtraParams is nullptr
@@ -1609,7 +1593,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureSetExtraParams_0008, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetExtraParams API via legal input
@@ -1655,7 +1639,7 @@ attr-sampling-rate=48000";
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetExtraParams API via setting the parameter render is nullptr
@@ -1682,7 +1666,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetExtraParams_0002, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetExtraParams API via setting listlength to be less than the actual length
@@ -1708,7 +1692,7 @@ HWTEST_F(AudioHdiCaptureAttrTest, SUB_Audio_HDI_CaptureGetExtraParams_0003, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
     * @tc.name  Test CaptureGetExtraParams API via setting listlenth equal to the actual length
@@ -1738,7 +1722,7 @@ attr-sampling-rate=48000";
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 #endif
 }
\ No newline at end of file
@@ -48,76 +48,18 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
 };
 
 TestAudioManager *(*AudioHdiCaptureControlTest::GetAudioManager)() = nullptr;
-void *AudioHdiCaptureControlTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiCaptureControlTest::SdkInit)() = nullptr;
-    void (*AudioHdiCaptureControlTest::SdkExit)() = nullptr;
-    void *AudioHdiCaptureControlTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiCaptureControlTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
-    if (GetAudioManager == nullptr) {
-        return;
-    }
+    GetAudioManager = AudioLoaderGetManagerFunc();
 }
 
 void AudioHdiCaptureControlTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
-    if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
-    }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiCaptureControlTest::SetUp(void) {}
@@ -140,7 +82,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0001, Func
     ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via creating a capture object when a render object was created
@@ -167,7 +109,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0002, Func
     InitDevDesc(DevDesc, audioPort->portId, PIN_IN_MIC);
     ret = adapter->CreateCapture(adapter, &DevDesc, &attrs, &firstCapture);
     if (ret < 0) {
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
     ret = adapter->CreateCapture(adapter, &DevDesc, &attrs, &secondCapture);
@@ -179,7 +121,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0002, Func
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
     adapter->DestroyCapture(adapter, firstCapture);
 #endif
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via creating a capture object when a render object was created
@@ -207,18 +149,18 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0003, Func
     InitDevDesc(captureDevDesc, audioPort->portId, PIN_IN_MIC);
     ret = adapter->CreateRender(adapter, &renderDevDesc, &attrs, &render);
     if (ret < 0) {
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
     ret = adapter->CreateCapture(adapter, &captureDevDesc, &attrs, &capture);
     if (ret < 0) {
         adapter->DestroyRender(adapter, render);
-        manager->UnloadAdapter(manager, adapter);
+        ReleaseLoadAdapter(manager, adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
     adapter->DestroyRender(adapter, render);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter adapter is nullptr
@@ -246,7 +188,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0005, Func
     ret = adapter->CreateCapture(adapterNull, &devDesc, &attrs, &capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter desc is nullptr
@@ -271,7 +213,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0006, Func
     ret = adapter->CreateCapture(adapter, devDesc, &attrs, &capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter attrs is nullptr
@@ -296,7 +238,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0007, Func
     ret = adapter->CreateCapture(adapter, &devDesc, attrs, &capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter capture is nullptr
@@ -322,7 +264,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0008, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = adapter->CreateCapture(adapter, &devDesc, &attrs, capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter adapter which port type is PORT_OUT
@@ -349,7 +291,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0009, Func
     ret = adapter->CreateCapture(adapter, &devDesc, &attrs, &capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCreateCapture API via setting the incoming parameter desc which portID is not configed
@@ -378,7 +320,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioCreateCapture_0010, Test
     ret = adapter->CreateCapture(adapter, &devDesc, &attrs, &capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioDestroyCapture API via legal input
@@ -397,7 +339,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioDestroyCapture_0001, Fun
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = adapter->DestroyCapture(adapter, capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioDestroyCapture API via setting the incoming parameter adapter is nullptr
@@ -419,7 +361,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioDestroyCapture_0002, Fun
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
     ret = adapter->DestroyCapture(adapter, capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioDestroyCapture API via setting the incoming parameter capture is nullptr
@@ -439,7 +381,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_AudioDestroyCapture_0003, Fun
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = adapter->DestroyCapture(adapter, capture);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStart API via legal input
@@ -462,7 +404,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStart_0001, Function |
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureStart API via setting the incoming parameter handle is nullptr
@@ -486,7 +428,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStart_0002, Function |
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStart API via startingtwo capture objects continuously
@@ -511,7 +453,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStart_0003, Function |
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStop API via legal input
@@ -533,7 +475,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStop_0001, Function |
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStop API via stopping two capture objects continuously
@@ -557,7 +499,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStop_0002, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStop API via starting an AudioCapture object that has been stopped
@@ -582,7 +524,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStop_0003, Function |
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureStop API via stopping an AudioCapture object that has not been started
@@ -604,7 +546,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStop_0004, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name Test CaptureStop API via setting the  parameter handle to nullptr
@@ -627,7 +569,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureStop_0005, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CapturePause API via legal input
@@ -651,7 +593,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CapturePause_0001, Function |
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CapturePause API via calling it twice
@@ -677,7 +619,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CapturePause_0002, Function |
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CapturePause API via setting the  parameter handle to nullptr
@@ -702,7 +644,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CapturePause_0003, Function |
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CapturePause API via pausing capture that has  not Started 
@@ -724,7 +666,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CapturePause_0004, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CapturePause API via pausing capture that has stopped
@@ -748,7 +690,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CapturePause_0005, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureResume API via legal input
@@ -773,7 +715,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0001, Function
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureResume API via calling it twice
@@ -801,7 +743,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0002, Function
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -826,7 +768,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0003, Function
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureResume API via setting the input parameter handle to nullptr
@@ -853,7 +795,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0004, Function
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureResume API via  resuming capture after stopped
@@ -877,7 +819,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0005, Function
     EXPECT_EQ(AUDIO_HAL_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureResume API via the continuing to start capture after resumed
@@ -904,7 +846,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0006, Function
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderResume API via starting,pausing,resuming, and stopping different capture objects     
@@ -931,7 +873,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0007, Function
     ret1 = captureOne->control.Stop((AudioHandle)captureOne);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret1);
     adapterOne->DestroyCapture(adapterOne, captureOne);
-    manager->UnloadAdapter(manager, adapterOne);
+    ReleaseLoadAdapter(manager, adapterOne);
     ret2 = AudioCreateStartCapture(manager, &captureSec, &adapterSec, ADAPTER_NAME);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret2);
     ret2 = captureSec->control.Pause((AudioHandle)captureSec);
@@ -941,7 +883,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureResume_0007, Function
     ret2 = captureSec->control.Stop((AudioHandle)captureSec);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret2);
     adapterSec->DestroyCapture(adapterSec, captureSec);
-    manager->UnloadAdapter(manager, adapterSec);
+    ReleaseLoadAdapter(manager, adapterSec);
 }
 /**
     * @tc.name  Test CaptureFlush API via flushing the data in the buffer  after stopped
@@ -965,7 +907,7 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureFlush_0001, Function |
     EXPECT_EQ(HDF_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test CaptureFlush via flushing the data in the buffer when handle is nullptr
@@ -990,6 +932,6 @@ HWTEST_F(AudioHdiCaptureControlTest, SUB_Audio_HDI_CaptureFlush_0002, Function |
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 }
@@ -48,77 +48,26 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
     int32_t AudioCaptureStart(const string path, struct AudioCapture *capture) const;
 };
 
 TestAudioManager *(*AudioHdiCaptureSceneTest::GetAudioManager)() = nullptr;
-void *AudioHdiCaptureSceneTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiCaptureSceneTest::SdkInit)() = nullptr;
-    void (*AudioHdiCaptureSceneTest::SdkExit)() = nullptr;
-    void *AudioHdiCaptureSceneTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiCaptureSceneTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
+    GetAudioManager = AudioLoaderGetManagerFunc();
     if (GetAudioManager == nullptr) {
         return;
     }
+    (void)AdapterCacheRetain(GetAudioManager(), true);
 }
 
 void AudioHdiCaptureSceneTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
     if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
+        AdapterCacheRelease(GetAudioManager());
     }
+    GetAudioManager = nullptr;
 }
 int32_t AudioHdiCaptureSceneTest::AudioCaptureStart(const string path, struct AudioCapture *capture) const
 {
@@ -163,7 +112,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_CaptureCheckSceneCapability_000
     EXPECT_TRUE(supported);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name   Test checking scene's capability where the scene is not configured in the json.
@@ -187,7 +136,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_CaptureCheckSceneCapability_000
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name   Test checking scene's capability where the capture is empty
@@ -216,7 +165,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_CaptureCheckSceneCapability_000
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name   Test checking scene's capability where the scene is empty
@@ -243,7 +192,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_CaptureCheckSceneCapability_000
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name   Test checking scene's capability where the parameter supported is empty.
@@ -267,7 +216,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_CaptureCheckSceneCapability_000
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSelectScene API via legal input
@@ -290,7 +239,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_AudioCaptureSelectScene_0001, F
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSelectScene API after capture start.
@@ -318,7 +267,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_AudioCaptureSelectScene_0002, F
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSelectScene API where the parameter handle is empty.
@@ -343,7 +292,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_AudioCaptureSelectScene_0003, F
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSelectScene API where the parameter scene is empty.
@@ -365,7 +314,7 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_AudioCaptureSelectScene_0004, F
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureSelectScene API where the scene is not configured in the json.
@@ -389,6 +338,6 @@ HWTEST_F(AudioHdiCaptureSceneTest, SUB_Audio_HDI_AudioCaptureSelectScene_0005, F
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 }
@@ -33,6 +33,7 @@
  * @version 1.0
  */
 
+#include <cmath>
 #include "audio_hdi_common.h"
 #include "audio_hdicapture_test.h"
 
@@ -44,6 +45,14 @@ namespace {
 const int BUFFER_SIZE = 16384;
 const int BUFFER_SIZE_LITTLE = 0;
 const uint64_t FILESIZE = 1024;
+const uint64_t VERIFY_FRAMES = 48000;
+const int16_t DC_OFFSET_SAMPLE = 8192;
+const double DC_OFFSET_LEVEL = 0.25;
+const double LEVEL_TOLERANCE = 0.001;
+/* a half-scale tone has an rms of 0.35; one zero frame is a zero crossing, a longer run is a dropout */
+const struct AudioPcmVerifyLimits TONE_LIMITS = {
+    .minRms = 0.25, .maxDcOffset = 0.01, .maxZeroRun = 2, .minCorrelation = 0.95
+};
 
 class AudioHdiCaptureTest : public testing::Test {
 public:
@@ -52,12 +61,6 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
 
     static int32_t GetLoadAdapterAudioPara(struct PrepareAudioPara& audiopara);
 };
@@ -65,67 +68,15 @@ public:
 using THREAD_FUNC = void *(*)(void *);
 
 TestAudioManager *(*AudioHdiCaptureTest::GetAudioManager)() = nullptr;
-void *AudioHdiCaptureTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiCaptureTest::SdkInit)() = nullptr;
-    void (*AudioHdiCaptureTest::SdkExit)() = nullptr;
-    void *AudioHdiCaptureTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiCaptureTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
-    if (GetAudioManager == nullptr) {
-        return;
-    }
+    GetAudioManager = AudioLoaderGetManagerFunc();
 }
 
 void AudioHdiCaptureTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
-    if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
-    }
+    GetAudioManager = nullptr;
 }
 
 
@@ -200,7 +151,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0001, Function | M
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -231,7 +182,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0002, Function | M
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureCaptureFrame API via setting the incoming parameter replyBytes is nullptr
@@ -259,7 +210,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0003, Function | M
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -292,7 +243,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0004, Function | M
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -321,7 +272,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0005, Function | M
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -355,13 +306,186 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0006, Function | M
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
     }
 }
 /**
+* @tc.name  Test AudioCaptureFrame API via recording through the asynchronous file writer
+* @tc.number  SUB_Audio_HDI_AudioCaptureFrame_0007
+* @tc.desc  Test AudioCaptureFrame interface,Returns 0 if every period not dropped by an overrun reaches the file
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0007, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC,
+        .path = AUDIO_CAPTURE_FILE.c_str(), .fileSize = FILESIZE
+    };
+    ASSERT_NE(nullptr, GetAudioManager);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(nullptr, audiopara.manager);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordAudio, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    EXPECT_GT(audiopara.recordStats.capturedBytes, FILESIZE * MEGABYTE);
+    // overruns depend on how fast the storage is, so they are reported rather than checked
+    RecordStatsPrint("record", audiopara.recordStats);
+    EXPECT_EQ(INITIAL_VALUE, audiopara.recordStats.writeErrors);
+    EXPECT_EQ(audiopara.recordStats.capturedBytes - audiopara.recordStats.droppedBytes,
+        audiopara.recordStats.writtenBytes);
+}
+/**
+* @tc.name  Test AudioCaptureFrame API via verifying the content of every captured period
+* @tc.number  SUB_Audio_HDI_AudioCaptureFrame_0008
+* @tc.desc  Test AudioCaptureFrame interface,Returns 0 if the recorded samples are all inspected and within full scale
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0008, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    uint32_t sampleBytes = PcmFormatToBits(AUDIO_FORMAT_PCM_16_BIT) >> MOVE_RIGHT_NUM;
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_IN, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_IN_MIC,
+        .path = AUDIO_CAPTURE_FILE.c_str(), .fileSize = FILESIZE
+    };
+    ASSERT_NE(nullptr, GetAudioManager);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(nullptr, audiopara.manager);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordAudio, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    const struct AudioPcmStats &pcm = audiopara.recordStats.pcm;
+    EXPECT_EQ(audiopara.recordStats.capturedBytes, pcm.samples * sampleBytes);
+    EXPECT_LE(pcm.rms, pcm.peak);
+    EXPECT_LE(pcm.peak, 1.0);
+    EXPECT_LE(pcm.longestZeroRun, pcm.samples);
+}
+/**
+* @tc.name  Test AudioCaptureFrame API via verifying a captured reference tone
+* @tc.number  SUB_Audio_HDI_AudioCaptureFrame_0009
+* @tc.desc  Test AudioCaptureFrame interface,Returns 0 if a 1kHz tone rendered on the same adapter is captured intact.
+*           The limits are only checked on a stand-in HAL, a device microphone does not hear the speaker reliably
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureFrame_0009, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioPcmStats stats = {};
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioAdapter *captureAdapter = nullptr;
+    struct AudioRender *render = nullptr;
+    struct AudioCapture *capture = nullptr;
+    ASSERT_NE(nullptr, GetAudioManager);
+    TestAudioManager *manager = GetAudioManager();
+    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &captureAdapter, &capture);
+    if (ret < 0) {
+        adapter->DestroyRender(adapter, render);
+        ReleaseLoadAdapter(manager, adapter);
+        ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    }
+
+    ret = CaptureToneVerify(render, capture, VERIFY_FRAMES, stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    PcmStatsPrint("captured tone", stats);
+    if (AudioLoaderOverridden()) {
+        EXPECT_LE(VERIFY_FRAMES * 2, stats.samples); // 2: stereo
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyCheck(stats, TONE_LIMITS));
+    }
+
+    captureAdapter->DestroyCapture(captureAdapter, capture);
+    ReleaseLoadAdapter(manager, captureAdapter);
+    adapter->DestroyRender(adapter, render);
+    ReleaseLoadAdapter(manager, adapter);
+}
+/**
+* @tc.name  Test the PCM verifier via a synthesized reference tone
+* @tc.number  SUB_Audio_HDI_AudioPcmVerify_0001
+* @tc.desc  Returns 0 if a half-scale 1kHz tone measures its own level and matches the reference
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioPcmVerify_0001, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    struct AudioPcmVerifier verifier = {};
+    struct AudioPcmStats stats = {};
+    InitAttrs(attrs);
+    PcmSynthDefault(params, AUDIO_SYNTH_SWEEP);
+    params.startHz = SYNTH_TONE_HZ;
+    params.endHz = SYNTH_TONE_HZ;
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmSynthInit(synth, attrs, params));
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyInit(verifier, attrs, SYNTH_TONE_HZ));
+    std::vector<char> frame(PcmFramesToBytes(attrs));
+    while (verifier.samples < VERIFY_FRAMES * attrs.channelCount) {
+        PcmVerifyFeed(verifier, frame.data(), PcmSynthFill(synth, frame.data(), frame.size()));
+    }
+
+    PcmVerifyResult(verifier, stats);
+    EXPECT_NEAR(SYNTH_AMPLITUDE, stats.peak, LEVEL_TOLERANCE);
+    EXPECT_NEAR(SYNTH_AMPLITUDE / std::sqrt(2.0), stats.rms, LEVEL_TOLERANCE); // 2: rms of a sine is peak / sqrt 2
+    EXPECT_NEAR(0.0, stats.dcOffset, LEVEL_TOLERANCE);
+    EXPECT_GE(TONE_LIMITS.maxZeroRun, stats.longestZeroRun);
+    EXPECT_NEAR(1.0, stats.correlation, LEVEL_TOLERANCE);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyCheck(stats, TONE_LIMITS));
+}
+/**
+* @tc.name  Test the PCM verifier via buffers of silence
+* @tc.number  SUB_Audio_HDI_AudioPcmVerify_0002
+* @tc.desc  Returns -1 if silence fed in several buffers is one zero run with no level and no tone
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioPcmVerify_0002, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioPcmVerifier verifier = {};
+    struct AudioPcmStats stats = {};
+    InitAttrs(attrs);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyInit(verifier, attrs, SYNTH_TONE_HZ));
+    std::vector<char> frame(PcmFramesToBytes(attrs), 0);
+    for (int index = 0; index < FRAME_COUNT; index++) {
+        PcmVerifyFeed(verifier, frame.data(), frame.size());
+    }
+
+    PcmVerifyResult(verifier, stats);
+    EXPECT_EQ(frame.size() * FRAME_COUNT / sizeof(int16_t), stats.samples);
+    EXPECT_EQ(stats.samples, stats.longestZeroRun);
+    EXPECT_EQ(0.0, stats.rms);
+    EXPECT_EQ(0.0, stats.peak);
+    EXPECT_EQ(0.0, stats.dcOffset);
+    EXPECT_EQ(0.0, stats.correlation);
+    EXPECT_EQ(HDF_FAILURE, PcmVerifyCheck(stats, TONE_LIMITS));
+}
+/**
+* @tc.name  Test the PCM verifier via a constant DC offset
+* @tc.number  SUB_Audio_HDI_AudioPcmVerify_0003
+* @tc.desc  Returns -1 if a quarter-scale DC level is measured as offset, rms and peak with no tone in it
+*/
+HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioPcmVerify_0003, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioPcmVerifier verifier = {};
+    struct AudioPcmStats stats = {};
+    InitAttrs(attrs);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyInit(verifier, attrs, SYNTH_TONE_HZ));
+    std::vector<int16_t> frame(PcmFramesToBytes(attrs) / sizeof(int16_t), DC_OFFSET_SAMPLE);
+    PcmVerifyFeed(verifier, frame.data(), frame.size() * sizeof(int16_t));
+
+    PcmVerifyResult(verifier, stats);
+    EXPECT_EQ(frame.size(), stats.samples);
+    EXPECT_EQ(INITIAL_VALUE, stats.longestZeroRun);
+    EXPECT_DOUBLE_EQ(DC_OFFSET_LEVEL, stats.dcOffset);
+    EXPECT_DOUBLE_EQ(DC_OFFSET_LEVEL, stats.rms);
+    EXPECT_DOUBLE_EQ(DC_OFFSET_LEVEL, stats.peak);
+    EXPECT_EQ(0.0, stats.correlation);
+    EXPECT_EQ(HDF_FAILURE, PcmVerifyCheck(stats, TONE_LIMITS));
+}
+/**
 * @tc.name  Test AudioCaptureGetCapturePosition API via legal input
 * @tc.number  SUB_Audio_HDI_AudioCaptureGetCapturePosition_0001
 * @tc.desc  Test AudioCaptureGetCapturePosition interface,Returns 0 if get CapturePosition during playing.
@@ -460,7 +584,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0003,
     EXPECT_GT(frames, INITIAL_VALUE);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via get CapturePosition after the object is created
@@ -485,7 +609,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0004,
     EXPECT_EQ((time.tvSec) * SECTONSEC + (time.tvNSec), timeExp);
 
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via setting the parameter Capture is nullptr
@@ -511,7 +635,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0005,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via setting the parameter frames is nullptr
@@ -536,7 +660,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0006,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via setting the parameter time is nullptr
@@ -561,7 +685,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0007,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via get CapturePosition continuously
@@ -594,7 +718,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0008,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via define format to AUDIO_FORMAT_PCM_16_BIT
@@ -640,7 +764,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0009,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via define format to AUDIO_FORMAT_PCM_24_BIT
@@ -686,7 +810,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0010,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via define sampleRate and channelCount to different value
@@ -732,7 +856,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0011,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCapturePosition API via define sampleRate and channelCount to 1
@@ -778,7 +902,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_AudioCaptureGetCapturePosition_0012,
 
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via legal input
@@ -815,7 +939,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0001, Function
     }
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is bigger than
@@ -852,7 +976,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0002, Function
     (void)fclose(fp);
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is smaller than
@@ -892,7 +1016,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0003, Function
     }
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is zero
@@ -928,7 +1052,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0004, Function
     (void)fclose(fp);
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter memoryFd  of desc is illegal
@@ -964,7 +1088,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0005, Function
     (void)fclose(fp);
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via the incoming parameter handle is nullptr
@@ -1000,7 +1124,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0006, Function
     (void)fclose(fp);
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via the incoming parameter desc is nullptr
@@ -1029,7 +1153,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureReqMmapBuffer_0007, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
     capture->control.Stop((AudioHandle)capture);
     adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 
 /**
@@ -1065,7 +1189,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0001, Functio
     ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordMapAudio, &audiopara);
     if (ret != 0) {
         audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
     sleep(1);
@@ -1084,7 +1208,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0001, Functio
 
     audiopara.capture->control.Stop((AudioHandle)audiopara.capture);
     audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test GetMmapPosition API via SetSampleAttributes and Getting position is normal.
@@ -1118,7 +1242,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0002, Functio
     ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)RecordMapAudio, &audiopara);
     if (ret != 0) {
         audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
 
@@ -1133,7 +1257,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0002, Functio
 
     audiopara.capture->control.Stop((AudioHandle)audiopara.capture);
     audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
 }
 /**
@@ -1163,7 +1287,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0003, Functio
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via inputtint time is nullptr.
@@ -1193,7 +1317,7 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0004, Functio
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via inputtint capture is nullptr.
@@ -1223,6 +1347,6 @@ HWTEST_F(AudioHdiCaptureTest, SUB_Audio_HDI_CaptureGetMmapPosition_0005, Functio
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyCapture(audiopara.adapter, audiopara.capture);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 }
\ No newline at end of file
@@ -34,6 +34,7 @@
  */
 
 #include "audio_hdi_common.h"
+#include "audio_hdi_perf.h"
 #include "audio_hdicapture_volume_test.h"
 
 using namespace std;
@@ -48,81 +49,37 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
+    static struct AudioStreamPool streamPool;
     int32_t AudioCaptureStart(const string path, struct AudioCapture *capture) const;
 };
 
 TestAudioManager *(*AudioHdiCaptureVolumeTest::GetAudioManager)() = nullptr;
-void *AudioHdiCaptureVolumeTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiCaptureVolumeTest::SdkInit)() = nullptr;
-    void (*AudioHdiCaptureVolumeTest::SdkExit)() = nullptr;
-    void *AudioHdiCaptureVolumeTest::sdkSo = nullptr;
-#endif
+struct AudioStreamPool AudioHdiCaptureVolumeTest::streamPool = {};
 
 void AudioHdiCaptureVolumeTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
+    GetAudioManager = AudioLoaderGetManagerFunc();
     if (GetAudioManager == nullptr) {
         return;
     }
+    (void)AdapterCacheRetain(GetAudioManager(), true);
+    StreamPoolInit(streamPool, GetAudioManager());
 }
 
 void AudioHdiCaptureVolumeTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
+    StreamPoolDeinit(streamPool);
     if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
+        AdapterCacheRelease(GetAudioManager());
     }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiCaptureVolumeTest::SetUp(void) {}
-void AudioHdiCaptureVolumeTest::TearDown(void) {}
+void AudioHdiCaptureVolumeTest::TearDown(void)
+{
+    StreamPoolReclaim(streamPool);
+}
 
 int32_t AudioHdiCaptureVolumeTest::AudioCaptureStart(const string path, struct AudioCapture *capture) const
 {
@@ -153,9 +110,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0001, Func
     bool muteFalse = false;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetMute(capture, muteTrue);
@@ -172,8 +127,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0001, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_FALSE(muteFalse);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetMute API via setting the capture is empty .
@@ -188,9 +142,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0002, Func
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.SetMute(captureNull, muteTrue);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
@@ -198,8 +150,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0002, Func
     ret = capture->volume.SetMute(captureNull, muteFalse);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetMute API,when the parameter mutevalue equals 2.
@@ -212,9 +163,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0003, Func
     int32_t ret = -1;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetMute(capture, muteValue);
@@ -224,8 +173,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetMute_0003, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_TRUE(muteValue);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetMute API via legal input.
@@ -240,9 +188,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetMute_0001, Func
     bool defaultmute = true;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetMute(capture, &muteTrue);
@@ -256,8 +202,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetMute_0001, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_FALSE(muteFalse);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test interface AudioCaptureGetMute when capture is empty.
@@ -272,9 +217,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetMute_0002, Func
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.GetMute(captureNull, &muteTrue);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
@@ -285,8 +228,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetMute_0002, Func
     ret = capture->volume.GetMute(capture, nullptr);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetVolume API via legal input.
@@ -306,9 +248,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetVolume_0001, Fu
     float volumeHighExpc = 0.70;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.SetVolume(capture, volumeInit);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -331,8 +271,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetVolume_0001, Fu
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(volumeHighExpc, volumeHigh);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetVolume,when volume is set maximum value or minimum value.
@@ -350,9 +289,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetVolume_0002, Fu
     float volumeMaxBoundary = 1.1;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetVolume(capture, volumeMin);
@@ -373,8 +310,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetVolume_0002, Fu
     ret = capture->volume.SetVolume(capture, volumeMaxBoundary);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetVolume,when capture is empty.
@@ -388,16 +324,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureSetVolume_0003, Fu
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetVolume(captureNull, volume);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetVolume API via legal input.
@@ -411,9 +344,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetVolume_001, Fun
     float defaultVolume = 0.60;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetVolume(capture, volume);
@@ -422,8 +353,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetVolume_001, Fun
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(defaultVolume, volume);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetVolume when when capturing is in progress.
@@ -437,9 +367,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetVolume_002, Fun
     float defaultVolume = 0.60;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = AudioCaptureStart(AUDIO_CAPTURE_FILE, capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -452,8 +380,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetVolume_002, Fun
 
     ret = capture->control.Stop((AudioHandle)capture);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetVolume,when capture is empty.
@@ -467,16 +394,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGetVolume_0003, Fu
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetVolume(captureNull, &volume);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGainThreshold API via legal input
@@ -490,9 +414,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGainThreshold_0001,
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, &max);
@@ -500,8 +422,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGainThreshold_0001,
     EXPECT_EQ(min, GAIN_MIN);
     EXPECT_EQ(max, GAIN_MAX);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGainThreshold API via setting the incoming parameter handle is nullptr
@@ -516,16 +437,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGainThreshold_0002,
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGainThreshold((AudioHandle)captureNull, &min, &max);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGainThreshold API via setting the incoming parameter min is nullptr
@@ -539,16 +457,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGainThreshold_0003,
     float* minNull = nullptr;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, minNull, &max);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGainThreshold API via setting the incoming parameter max is nullptr
@@ -562,16 +477,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGainThreshold_0004,
     float* maxNull = nullptr;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, maxNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetGain API via legal input
@@ -585,9 +497,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureSetGain_0001, Function
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, &max);
@@ -616,8 +526,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureSetGain_0001, Function
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(gainExpc, gain);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetGain API via setting gain greater than the maximum and less than the minimum
@@ -631,9 +540,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureSetGain_0002, Function
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, &max);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -646,8 +553,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureSetGain_0002, Function
     ret = capture->volume.SetGain((AudioHandle)capture, gainSec);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureSetGain API via setting the incoming parameter handle is nullptr.
@@ -661,16 +567,13 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureSetGain_0003, Function
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetGain((AudioHandle)captureNull, gain);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGain API via legal input
@@ -684,9 +587,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0001, Function
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, &max);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -700,8 +601,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0001, Function
     EXPECT_EQ(gainValue, gain);
 
     capture->control.Stop((AudioHandle)capture);
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGain API via setting the incoming parameter handle is nullptr
@@ -715,14 +615,11 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0002, Function
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     struct AudioCapture *captureNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = capture->volume.GetGain((AudioHandle)captureNull, &gainValue);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGain API via legal input in difference scenes
@@ -736,9 +633,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0003, Function
     float gainOne = GAIN_MAX-1;
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.SetGain((AudioHandle)capture, gain);
@@ -747,8 +642,7 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0003, Function
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(gainOne, gain);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
 }
 /**
 * @tc.name  Test AudioCaptureGetGain API via setting the parameter gain is nullptr
@@ -761,15 +655,43 @@ HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_hdi_CaptureGetGain_0004, Function
     struct AudioAdapter *adapter = nullptr;
     struct AudioCapture *capture = nullptr;
     float *gainNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &adapter, &capture);
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = capture->volume.GetGain((AudioHandle)capture, gainNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyCapture(adapter, capture);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
+}
+/**
+* @tc.name  Test AudioCaptureSetGain driven as a fast ramp during capture
+* @tc.number  SUB_Audio_HDI_AudioCaptureGainRamp_0001
+* @tc.desc  Ramps the gain of a running capture across its threshold range 2000 times per second while the
+*           captured envelope is tracked; returns 0 if every SetGain succeeds and the capture keeps running
+*/
+HWTEST_F(AudioHdiCaptureVolumeTest, SUB_Audio_HDI_AudioCaptureGainRamp_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    float min = 0;
+    float max = 0;
+    struct AudioRampParams params = {};
+    struct AudioRampReport report = {};
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioCapture *capture = nullptr;
+    ret = StreamPoolAcquireCapture(streamPool, &adapter, &capture);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = capture->volume.GetGainThreshold((AudioHandle)capture, &min, &max);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    RampParamsDefault(params, AUDIO_RAMP_GAIN, min, max);
+    ret = CaptureRampRun(capture, params, report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    RampReportPrint("capture gain ramp", report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, report.result);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, report.streamResult);
+    EXPECT_LT(INITIAL_VALUE, report.updates);
+    EXPECT_LT(INITIAL_VALUE, report.monitoredBytes);
+
+    StreamPoolReleaseCapture(streamPool, adapter, capture);
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Audio
+ * @{
+ *
+ * @brief Defines audio-related APIs, including custom data types and functions for loading drivers,
+ * accessing a driver adapter, and rendering and capturing audios.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+/**
+ * @file audio_hdi_loopback_test.cpp
+ *
+ * @brief Smoke tests that load the loopback stand-in HAL through AUDIO_HAL_LIBRARY and drive it end to end.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#include <cstdlib>
+#include "audio_hdi_common.h"
+#include "audio_hdi_loopback_test.h"
+
+using namespace std;
+using namespace testing::ext;
+using namespace HMOS::Audio;
+
+namespace {
+/* pushed next to the suite by Test.json; an AUDIO_HAL_LIBRARY already set in the environment wins */
+const std::string LOOPBACK_LIBRARY = "/data/local/tmp/libhdi_audio_loopback.z.so";
+const uint64_t VERIFY_FRAMES = 48000;
+const struct AudioPcmVerifyLimits TONE_LIMITS = {
+    .minRms = 0.25, .maxDcOffset = 0.01, .maxZeroRun = 2, .minCorrelation = 0.95
+};
+
+class AudioHdiLoopbackTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+    static TestAudioManager *(*GetAudioManager)();
+};
+
+TestAudioManager *(*AudioHdiLoopbackTest::GetAudioManager)() = nullptr;
+
+void AudioHdiLoopbackTest::SetUpTestCase(void)
+{
+    (void)setenv(HAL_LIBRARY_ENV, LOOPBACK_LIBRARY.c_str(), 0);
+    GetAudioManager = AudioLoaderGetManagerFunc();
+}
+
+void AudioHdiLoopbackTest::TearDownTestCase(void)
+{
+    GetAudioManager = nullptr;
+}
+
+void AudioHdiLoopbackTest::SetUp(void) {}
+
+void AudioHdiLoopbackTest::TearDown(void) {}
+
+/**
+* @tc.name  Test loading the loopback HAL via AUDIO_HAL_LIBRARY
+* @tc.number  SUB_Audio_HDI_AudioLoopbackLoad_0001
+* @tc.desc  Returns 0 if the stand-in library replaces the vendor HAL and lists the primary adapter
+*/
+HWTEST_F(AudioHdiLoopbackTest, SUB_Audio_HDI_AudioLoopbackLoad_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    int size = 0;
+    struct AudioAdapterDescriptor *descs = nullptr;
+    struct AudioPort *renderPort = nullptr;
+    struct AudioPort *capturePort = nullptr;
+    ASSERT_NE(nullptr, GetAudioManager);
+    EXPECT_TRUE(AudioLoaderOverridden());
+    TestAudioManager *manager = GetAudioManager();
+    ASSERT_NE(nullptr, manager);
+
+    ret = manager->GetAllAdapters(manager, &descs, &size);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    EXPECT_LE(0, SwitchAdapter(descs, ADAPTER_NAME, PORT_OUT, renderPort, size));
+    EXPECT_LE(0, SwitchAdapter(descs, ADAPTER_NAME, PORT_IN, capturePort, size));
+}
+/**
+* @tc.name  Test a reference tone round trip through the loopback HAL
+* @tc.number  SUB_Audio_HDI_AudioLoopbackTone_0001
+* @tc.desc  Returns 0 if a 1kHz tone rendered on the primary adapter is captured back within the tone limits
+*/
+HWTEST_F(AudioHdiLoopbackTest, SUB_Audio_HDI_AudioLoopbackTone_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioPcmStats stats = {};
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioAdapter *captureAdapter = nullptr;
+    struct AudioRender *render = nullptr;
+    struct AudioCapture *capture = nullptr;
+    ASSERT_NE(nullptr, GetAudioManager);
+    TestAudioManager *manager = GetAudioManager();
+    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = AudioCreateCapture(manager, PIN_IN_MIC, ADAPTER_NAME, &captureAdapter, &capture);
+    if (ret < 0) {
+        adapter->DestroyRender(adapter, render);
+        ReleaseLoadAdapter(manager, adapter);
+        ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    }
+
+    ret = CaptureToneVerify(render, capture, VERIFY_FRAMES, stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    PcmStatsPrint("loopback tone", stats);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, PcmVerifyCheck(stats, TONE_LIMITS));
+
+    captureAdapter->DestroyCapture(captureAdapter, capture);
+    ReleaseLoadAdapter(manager, captureAdapter);
+    adapter->DestroyRender(adapter, render);
+    ReleaseLoadAdapter(manager, adapter);
+}
+/**
+* @tc.name  Test the loopback HAL render callbacks via RenderFrame and DrainBuffer
+* @tc.number  SUB_Audio_HDI_AudioLoopbackCallback_0001
+* @tc.desc  Returns 0 if the cookie registered by RegCallback receives a write completion and a drain completion
+*/
+HWTEST_F(AudioHdiLoopbackTest, SUB_Audio_HDI_AudioLoopbackCallback_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    uint64_t replyBytes = 0;
+    enum AudioDrainNotifyType type = AUDIO_DRAIN_NORMAL_MODE;
+    struct AudioSampleAttributes attrs = {};
+    struct AudioRenderEvent event = {};
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioRender *render = nullptr;
+    /* the loopback signals from inside RenderFrame and DrainBuffer, so no callback outlives the test */
+    struct AudioRenderEventQueue queue;
+    RenderEventQueueInit(queue);
+    ASSERT_NE(nullptr, GetAudioManager);
+    TestAudioManager *manager = GetAudioManager();
+    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    InitAttrs(attrs);
+    std::vector<char> frame(PcmFramesToBytes(attrs), 0);
+
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, render->RegCallback(render, AudioRenderEventCallback, &queue));
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, render->control.Start((AudioHandle)render));
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, render->RenderFrame(render, frame.data(), frame.size(), &replyBytes));
+    EXPECT_TRUE(RenderEventQueuePop(queue, event));
+    EXPECT_EQ(AUDIO_NONBLOCK_WRITE_COMPELETED, event.type);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, render->DrainBuffer(render, &type));
+    EXPECT_TRUE(RenderEventQueuePop(queue, event));
+    EXPECT_EQ(AUDIO_DRAIN_COMPELETED, event.type);
+    EXPECT_FALSE(RenderEventQueuePop(queue, event));
+
+    (void)render->control.Stop((AudioHandle)render);
+    adapter->DestroyRender(adapter, render);
+    ReleaseLoadAdapter(manager, adapter);
+}
+}
@@ -34,6 +34,7 @@
  */
 
 #include "audio_hdi_common.h"
+#include "audio_hdi_perf.h"
 #include "audio_hdirender_attr_test.h"
 
 using namespace std;
@@ -48,78 +49,27 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
 };
 
 using THREAD_FUNC = void *(*)(void *);
 
 TestAudioManager *(*AudioHdiRenderAttrTest::GetAudioManager)() = nullptr;
-void *AudioHdiRenderAttrTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiRenderAttrTest::SdkInit)() = nullptr;
-    void (*AudioHdiRenderAttrTest::SdkExit)() = nullptr;
-    void *AudioHdiRenderAttrTest::sdkSo = nullptr;
-#endif
 
 void AudioHdiRenderAttrTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
+    GetAudioManager = AudioLoaderGetManagerFunc();
     if (GetAudioManager == nullptr) {
         return;
     }
+    (void)AdapterCacheRetain(GetAudioManager(), true);
 }
 
 void AudioHdiRenderAttrTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
     if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
+        AdapterCacheRelease(GetAudioManager());
     }
+    GetAudioManager = nullptr;
 }
 void AudioHdiRenderAttrTest::SetUp(void) {}
 void AudioHdiRenderAttrTest::TearDown(void) {}
@@ -159,7 +109,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -194,7 +144,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -229,7 +179,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -264,7 +214,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -299,7 +249,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -333,7 +283,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via setting the render is empty .
@@ -359,7 +309,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -394,7 +344,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -428,7 +378,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -463,7 +413,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -498,7 +448,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via legal input.
@@ -533,7 +483,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(ret1, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via illegal input.
@@ -560,7 +510,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_NOT_SUPPORT, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via illegal input.
@@ -598,7 +548,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via illegal input.
@@ -635,7 +585,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via illegal input.
@@ -667,7 +617,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderSetSampleAttributes API via illegal input.
@@ -694,7 +644,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetSampleAttributes API via legal input.
@@ -729,7 +679,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderGetSampleAttributes_00
     EXPECT_EQ(ret2, attrsValue.channelCount);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRendereGetSampleAttributes API via setting the render is empty .
@@ -756,7 +706,41 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderGetSampleAttributes_00
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
+}
+/**
+* @tc.name  Test AudioRenderSetSampleAttributes across the legal format, channel, rate and period matrix
+* @tc.number  SUB_Audio_HDI_AudioRenderSampleAttributesMatrix_0001
+* @tc.desc  Applies every combination to one render, prints set/get and first-frame latency as CSV, and returns 0
+*           if each combination is accepted, read back unchanged and renders a frame
+*/
+HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_AudioRenderSampleAttributesMatrix_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    std::vector<struct AudioAttrSweepCase> cases;
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER
+    };
+    ASSERT_NE(nullptr, GetAudioManager);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(nullptr, audiopara.manager);
+    ret = AudioCreateRender(audiopara.manager, audiopara.pins, audiopara.adapterName, &audiopara.adapter,
+                            &audiopara.render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    ret = RenderAttrSweep(audiopara, ATTR_SWEEP_LEGAL, cases);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    AttrSweepPrintCsv("render", cases);
+    EXPECT_EQ(ATTR_SWEEP_LEGAL.formatCount * ATTR_SWEEP_LEGAL.channelCount * ATTR_SWEEP_LEGAL.sampleRateCount *
+        ATTR_SWEEP_LEGAL.periodCount, cases.size());
+    for (const struct AudioAttrSweepCase &sweepCase : cases) {
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, sweepCase.result);
+        EXPECT_TRUE(sweepCase.matched);
+        EXPECT_LE(0, sweepCase.firstFrameNs);
+    }
+
+    audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API via legal input
@@ -780,7 +764,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0001, Function
     EXPECT_GT(size, zero);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioCaptureGetFrameSize API via setting the incoming parameter handle is nullptr
@@ -803,7 +787,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0002, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API setting the incoming parameter FrameSize is nullptr
@@ -825,7 +809,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0003, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API via define format to different values
@@ -859,7 +843,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0004, Function
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API via define sampleRate to different values
@@ -893,7 +877,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0005, Function
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API via define channelCount to different values
@@ -927,7 +911,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0006, Function
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameSize API via define sampleRate to different value
@@ -961,7 +945,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameSize_0007, Function
     EXPECT_GT(size, INITIAL_VALUE);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via legal
@@ -987,7 +971,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0001, Functio
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via setting the incoming parameter handle is nullptr
@@ -1012,7 +996,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0002, Functio
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API setting the incoming parameter count is nullptr
@@ -1036,7 +1020,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0003, Functio
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via define channelCount to different value
@@ -1074,7 +1058,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0004, Functio
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via define format to different value
@@ -1112,7 +1096,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0005, Functio
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via define channelCount to different value
@@ -1149,7 +1133,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0006, Functio
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetFrameCount API via define format to different value
@@ -1186,7 +1170,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetFrameCount_0007, Functio
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetCurrentChannelId API via legal input
@@ -1210,7 +1194,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetCurrentChannelId_0001, F
     EXPECT_EQ(channelIdValue, channelId);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCurrentChannelId API via get channelId to 1 and set channelCount to 1
@@ -1242,7 +1226,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetCurrentChannelId_0002, F
     EXPECT_EQ(channelIdExp, channelId);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetCurrentChannelId API via CurrentChannelId is obtained after created
@@ -1266,7 +1250,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetCurrentChannelId_0003, F
     EXPECT_EQ(channelIdExp, channelId);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetCurrentChannelId API via setting the parameter render is nullptr
@@ -1289,7 +1273,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetCurrentChannelId_0004, F
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetCurrentChannelId API via setting the parameter channelId is nullptr
@@ -1311,7 +1295,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetCurrentChannelId_0005, F
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 #if defined (AUDIO_ADM_SERVICE) || defined (AUDIO_ADM_SO) || defined (__LITEOS__)
 /**
@@ -1409,7 +1393,7 @@ attr-sampling-rate=48000";
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via setting keyvaluelist to a value outside the range
@@ -1431,7 +1415,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderSetExtraParams_0003, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via adding parameters to keyvaluelist
@@ -1454,7 +1438,7 @@ attr-para=123";
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via setting ExtraParams When the key is the same and the value is
@@ -1487,7 +1471,7 @@ attr-sampling-rate=96000";
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via setting the parameter in keyvaluelist as an abnormal value
@@ -1521,7 +1505,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderSetExtraParams_0006, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via setting the parameter render is nullptr
@@ -1544,7 +1528,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderSetExtraParams_0007, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderSetExtraParams API via setting the format of ExtraParams is nullptr
@@ -1566,7 +1550,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderSetExtraParams_0008, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetExtraParams API via legal input
@@ -1612,7 +1596,7 @@ attr-sampling-rate=48000";
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetExtraParams API via setting the parameter render is nullptr
@@ -1639,7 +1623,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetExtraParams_0002, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetExtraParams API via setting listlength to be less than the actual length
@@ -1665,7 +1649,7 @@ HWTEST_F(AudioHdiRenderAttrTest, SUB_Audio_HDI_RenderGetExtraParams_0003, Functi
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetExtraParams API via setting listlenth equal to the actual length
@@ -1695,7 +1679,7 @@ attr-sampling-rate=48000";
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 #endif
 }
\ No newline at end of file
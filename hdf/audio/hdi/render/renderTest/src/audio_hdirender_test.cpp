@@ -33,6 +33,7 @@
  * @version 1.0
  */
 
+#include <cmath>
 #include "audio_hdi_common.h"
 #include "audio_hdirender_test.h"
 
@@ -41,6 +42,13 @@ using namespace testing::ext;
 using namespace HMOS::Audio;
 
 namespace {
+const uint32_t SYNTH_TEST_FRAMES = 4800;
+const uint32_t SYNTH_IMPULSE_PERIOD = 100;
+/* odd sized fills so a pass ends part way through the generator's lanes and blocks */
+const size_t SYNTH_FILL_FRAMES = 333;
+const double SYNTH_LEVEL_TOLERANCE = 0.01;
+const double SYNTH_TONE_TOLERANCE = 0.0001;
+
 class AudioHdiRenderTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -48,78 +56,20 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
     static int32_t GetLoadAdapterAudioPara(struct PrepareAudioPara& audiopara);
 };
 
 using THREAD_FUNC = void *(*)(void *);
 
 TestAudioManager *(*AudioHdiRenderTest::GetAudioManager)() = nullptr;
-void *AudioHdiRenderTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiRenderTest::SdkInit)() = nullptr;
-    void (*AudioHdiRenderTest::SdkExit)() = nullptr;
-    void *AudioHdiRenderTest::sdkSo = nullptr;
-#endif
 void AudioHdiRenderTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
-    if (GetAudioManager == nullptr) {
-        return;
-    }
+    GetAudioManager = AudioLoaderGetManagerFunc();
 }
 
 void AudioHdiRenderTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
-    if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
-    }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiRenderTest::SetUp(void) {}
@@ -188,7 +138,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetLatency_0001, Function
 
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetLatency API via Setting parameters render is empty
@@ -212,7 +162,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetLatency_0002, Function
 
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test RenderGetLatency API via Setting parameters ms is empty
@@ -235,7 +185,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetLatency_0003, Function
 
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test SetRenderSpeed API via legal
@@ -259,7 +209,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetRenderSpeed_0001, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test SetRenderSpeed API via setting the incoming parameter handle is nullptr
@@ -284,7 +234,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetRenderSpeed_0002, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderSpeed API via legal
@@ -307,7 +257,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderSpeed_0001, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderSpeed API via setting the incoming parameter handle is nullptr
@@ -332,7 +282,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderSpeed_0002, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderSpeed API via setting the incoming parameter speed is nullptr
@@ -356,7 +306,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderSpeed_0003, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderFrame API via legal input
@@ -385,7 +335,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0001, Function | Med
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -420,7 +370,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0002, Function | Med
 
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -451,7 +401,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0003, Function | Med
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderFrame API via setting the incoming parameter replyBytes is nullptr
@@ -481,7 +431,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0004, Function | Med
 
     ret = render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
@@ -511,13 +461,165 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0005, Function | Med
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
     if (frame != nullptr) {
         free(frame);
         frame = nullptr;
     }
 }
 /**
+* @tc.name  Test AudioRenderFrame API via frames handed over from a memory-mapped wav file
+* @tc.number  SUB_Audio_HDI_AudioRenderFrame_0006
+* @tc.desc  Test AudioRenderFrame interface,Returns 0 if the whole file is rendered from the file mapping
+*/
+HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0006, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    uint64_t frames = 0;
+    struct AudioTimeStamp time = {.tvSec = 0, .tvNSec = 0};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER,
+        .path = AUDIO_FILE.c_str()
+    };
+    audiopara.source = AUDIO_SOURCE_MMAP;
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayAudioFile, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.render != nullptr) {
+        ret = audiopara.render->GetRenderPosition(audiopara.render, &frames, &time);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        EXPECT_GT(frames, INITIAL_VALUE);
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+/**
+* @tc.name  Test AudioRenderFrame API via frames produced by the synthetic signal generator
+* @tc.number  SUB_Audio_HDI_AudioRenderFrame_0007
+* @tc.desc  Test AudioRenderFrame interface,Returns 0 if a generated sine sweep is rendered without any wav fixture
+*/
+HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderFrame_0007, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    uint64_t frames = 0;
+    struct AudioTimeStamp time = {.tvSec = 0, .tvNSec = 0};
+    struct PrepareAudioPara audiopara = {
+        .portType = PORT_OUT, .adapterName = ADAPTER_NAME.c_str(), .self = this, .pins = PIN_OUT_SPEAKER,
+        .path = AUDIO_FILE.c_str()
+    };
+    audiopara.source = AUDIO_SOURCE_SYNTH;
+    ASSERT_NE(GetAudioManager, nullptr);
+    audiopara.manager = GetAudioManager();
+    ASSERT_NE(audiopara.manager, nullptr);
+
+    ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayAudioFile, &audiopara);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    sleep(1);
+    if (audiopara.render != nullptr) {
+        ret = audiopara.render->GetRenderPosition(audiopara.render, &frames, &time);
+        EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+        EXPECT_GT(frames, INITIAL_VALUE);
+    }
+
+    ret = ThreadRelease(audiopara);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+}
+/**
+* @tc.name  Test the synthetic signal generator via white noise
+* @tc.number  SUB_Audio_HDI_AudioPcmSynth_0001
+* @tc.desc  Returns 0 if the noise has no dc, the rms of uniform noise and different samples on each channel
+*/
+HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioPcmSynth_0001, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    InitAttrs(attrs);
+    PcmSynthDefault(params, AUDIO_SYNTH_NOISE);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmSynthInit(synth, attrs, params));
+    std::vector<int16_t> samples(SYNTH_TEST_FRAMES * attrs.channelCount);
+    ASSERT_EQ(samples.size() * sizeof(int16_t), PcmSynthFill(synth, samples.data(), samples.size() * sizeof(int16_t)));
+
+    double sum = 0;
+    double squares = 0;
+    uint32_t sameChannels = 0;
+    for (size_t index = 0; index < samples.size(); index++) {
+        double level = samples[index] / 32768.0; // 32768: 16-bit full scale
+        sum += level;
+        squares += level * level;
+        sameChannels += (index % attrs.channelCount != 0 && samples[index] == samples[index - 1]) ? 1 : 0;
+    }
+    EXPECT_NEAR(0.0, sum / samples.size(), SYNTH_LEVEL_TOLERANCE);
+    // 3: rms of uniform noise is peak / sqrt 3
+    EXPECT_NEAR(SYNTH_AMPLITUDE / std::sqrt(3.0), std::sqrt(squares / samples.size()), SYNTH_LEVEL_TOLERANCE);
+    EXPECT_EQ(0U, sameChannels);
+}
+/**
+* @tc.name  Test the synthetic signal generator via impulses
+* @tc.number  SUB_Audio_HDI_AudioPcmSynth_0002
+* @tc.desc  Returns 0 if every channel is at the amplitude on each impulse frame and silent in between
+*/
+HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioPcmSynth_0002, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    InitAttrs(attrs);
+    PcmSynthDefault(params, AUDIO_SYNTH_IMPULSE);
+    params.impulsePeriod = SYNTH_IMPULSE_PERIOD;
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmSynthInit(synth, attrs, params));
+    std::vector<int16_t> samples(SYNTH_TEST_FRAMES * attrs.channelCount);
+    size_t fillSize = SYNTH_FILL_FRAMES * attrs.channelCount;
+    for (size_t done = 0; done < samples.size(); done += fillSize) {
+        size_t count = std::min(fillSize, samples.size() - done);
+        ASSERT_EQ(count * sizeof(int16_t), PcmSynthFill(synth, samples.data() + done, count * sizeof(int16_t)));
+    }
+
+    int16_t peak = static_cast<int16_t>(std::lrint(SYNTH_AMPLITUDE * 32767)); // 32767: 16-bit full scale
+    uint32_t mismatches = 0;
+    for (size_t index = 0; index < samples.size(); index++) {
+        bool impulse = index / attrs.channelCount % SYNTH_IMPULSE_PERIOD == 0;
+        mismatches += samples[index] == (impulse ? peak : 0) ? 0 : 1;
+    }
+    EXPECT_EQ(0U, mismatches);
+}
+/**
+* @tc.name  Test the synthetic signal generator via a steady tone filled in odd sized buffers
+* @tc.number  SUB_Audio_HDI_AudioPcmSynth_0003
+* @tc.desc  Returns 0 if the tone follows the reference sine across fills, blocks and oscillator lanes
+*/
+HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioPcmSynth_0003, Function | MediumTest | Level1)
+{
+    struct AudioSampleAttributes attrs = {};
+    struct AudioSynthParams params = {};
+    struct AudioPcmSynth synth = {};
+    InitAttrs(attrs);
+    attrs.format = AUDIO_FORMAT_PCM_32_BIT;
+    PcmSynthDefault(params, AUDIO_SYNTH_SWEEP);
+    params.startHz = SYNTH_TONE_HZ;
+    params.endHz = SYNTH_TONE_HZ;
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, PcmSynthInit(synth, attrs, params));
+    std::vector<int32_t> samples(SYNTH_TEST_FRAMES * attrs.channelCount);
+    size_t fillSize = SYNTH_FILL_FRAMES * attrs.channelCount;
+    for (size_t done = 0; done < samples.size(); done += fillSize) {
+        size_t count = std::min(fillSize, samples.size() - done);
+        ASSERT_EQ(count * sizeof(int32_t), PcmSynthFill(synth, samples.data() + done, count * sizeof(int32_t)));
+    }
+
+    double maxError = 0;
+    for (size_t index = 0; index < samples.size(); index++) {
+        double phase = 2 * M_PI * SYNTH_TONE_HZ * (index / attrs.channelCount) / attrs.sampleRate; // 2: one turn
+        double expected = SYNTH_AMPLITUDE * std::sin(phase);
+        maxError = std::max(maxError, std::fabs(samples[index] / 2147483647.0 - expected)); // 32-bit full scale
+    }
+    EXPECT_GT(SYNTH_TONE_TOLERANCE, maxError);
+}
+/**
 * @tc.name  Test SetChannelMode API via setting channel mode to different enumeration values
 * @tc.number  SUB_Audio_HDI_AudioRenderSetChannelMode_0001
 * @tc.desc  Test SetChannelMode interface,return 0 if set channel mode to different enumeration values
@@ -558,7 +660,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetChannelMode_0001, Funct
     EXPECT_EQ(AUDIO_CHANNEL_EXCHANGE, modeTrd);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test SetChannelMode API via setting channel mode to different values
@@ -601,7 +703,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetChannelMode_0002, Funct
     EXPECT_EQ(AUDIO_CHANNEL_BOTH_MUTE, modeTrd);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test SetChannelMode API via setting channel mode after render object is created
@@ -626,7 +728,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetChannelMode_0003, Funct
     EXPECT_EQ(AUDIO_CHANNEL_NORMAL, mode);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test SetChannelMode API via setting the parameter render is nullptr
@@ -650,7 +752,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderSetChannelMode_0004, Funct
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetChannelMode API via getting the channel mode after setting
@@ -679,7 +781,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetChannelMode_0001, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetChannelMode API via getting the parameter render is nullptr
@@ -705,7 +807,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetChannelMode_0002, Funct
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetChannelMode API via getting the channel mode after the render object is created
@@ -728,7 +830,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetChannelMode_0003, Funct
     EXPECT_EQ(AUDIO_CHANNEL_NORMAL, mode);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderPosition API via legal input
@@ -832,7 +934,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0003, Fu
     EXPECT_GT(frames, INITIAL_VALUE);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetRenderPosition API via setting the parameter render is nullptr
@@ -857,7 +959,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0004, Fu
     EXPECT_EQ((time.tvSec) * SECTONSEC + (time.tvNSec), timeExp);
 
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetRenderPosition API via setting the parameter render is nullptr
@@ -882,7 +984,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0005, Fu
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetRenderPosition API via setting the parameter frames is nullptr
@@ -907,7 +1009,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0006, Fu
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetRenderPosition API via setting the parameter time is nullptr
@@ -933,7 +1035,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0007, Fu
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test AudioRenderGetRenderPosition API via get RenderPosition continuously
@@ -963,7 +1065,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0008, Fu
 
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderPosition API via define format to AUDIO_FORMAT_PCM_16_BIT
@@ -1007,7 +1109,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0009, Fu
     EXPECT_GT(frames, INITIAL_VALUE);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderPosition API via define format to AUDIO_FORMAT_PCM_24_BIT
@@ -1051,7 +1153,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0010, Fu
     EXPECT_GT(frames, INITIAL_VALUE);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderPosition API via define sampleRate and channelCount to different value
@@ -1095,7 +1197,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0011, Fu
     EXPECT_GT(frames, INITIAL_VALUE);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetRenderPosition API via define sampleRate and channelCount to 1
@@ -1139,7 +1241,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_AudioRenderGetRenderPosition_0012, Fu
     EXPECT_GT(frames, INITIAL_VALUE);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via legal input
@@ -1182,7 +1284,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0001, Function |
     }
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is bigger than
@@ -1219,7 +1321,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0002, Function |
     fclose(fp);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is smaller than
@@ -1259,7 +1361,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0003, Function |
     }
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter reqSize is zero
@@ -1295,7 +1397,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0004, Function |
     fclose(fp);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via setting the incoming parameter memoryFd  of desc is illegal
@@ -1331,7 +1433,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0005, Function |
     fclose(fp);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via the incoming parameter handle is nullptr
@@ -1367,7 +1469,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0006, Function |
     fclose(fp);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via the incoming parameter desc is nullptr
@@ -1403,7 +1505,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderReqMmapBuffer_0007, Function |
     fclose(fp);
     render->control.Stop((AudioHandle)render);
     adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    ReleaseLoadAdapter(manager, adapter);
 }
 /**
 * @tc.name  Test GetMmapPosition API via Getting position is normal in Before playing and Playing.
@@ -1441,7 +1543,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0001, Function
     ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayMapAudioFile, &audiopara);
     if (ret != 0) {
         audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
     sleep(1);
@@ -1459,7 +1561,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0001, Function
     EXPECT_GE(framesexpRender, framesRendering);
     audiopara.render->control.Stop((AudioHandle)audiopara.render);
     audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test GetMmapPosition API via SetSampleAttributes and Getting position is normal.
@@ -1493,7 +1595,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0002, Function
     ret = pthread_create(&audiopara.tids, NULL, (THREAD_FUNC)PlayMapAudioFile, &audiopara);
     if (ret != 0) {
         audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-        audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+        ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
         ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     }
 
@@ -1506,7 +1608,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0002, Function
     EXPECT_GT(frames, INITIAL_VALUE);
     audiopara.render->control.Stop((AudioHandle)audiopara.render);
     audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via inputtint frame is nullptr.
@@ -1535,7 +1637,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0003, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via inputtint time is nullptr.
@@ -1565,7 +1667,7 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0004, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 /**
 * @tc.name  Test ReqMmapBuffer API via inputtint render is nullptr.
@@ -1595,6 +1697,6 @@ HWTEST_F(AudioHdiRenderTest, SUB_Audio_HDI_RenderGetMmapPosition_0005, Function
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
     audiopara.adapter->DestroyRender(audiopara.adapter, audiopara.render);
-    audiopara.manager->UnloadAdapter(audiopara.manager, audiopara.adapter);
+    ReleaseLoadAdapter(audiopara.manager, audiopara.adapter);
 }
 }
\ No newline at end of file
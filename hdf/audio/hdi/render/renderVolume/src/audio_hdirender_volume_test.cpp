@@ -34,6 +34,7 @@
  */
 
 #include "audio_hdi_common.h"
+#include "audio_hdi_perf.h"
 #include "audio_hdirender_volume_test.h"
 
 using namespace std;
@@ -41,6 +42,8 @@ using namespace testing::ext;
 using namespace HMOS::Audio;
 
 namespace {
+const std::string CARD_SERVICE_NAME = "hdf_audio_codec_dev0";
+
 class AudioHdiRenderVolumeTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -48,80 +51,37 @@ public:
     void SetUp();
     void TearDown();
     static TestAudioManager *(*GetAudioManager)();
-    static void *handleSo;
-#ifdef AUDIO_MPI_SO
-    static int32_t (*SdkInit)();
-    static void (*SdkExit)();
-    static void *sdkSo;
-#endif
+    static struct AudioStreamPool streamPool;
 };
 
 TestAudioManager *(*AudioHdiRenderVolumeTest::GetAudioManager)() = nullptr;
-void *AudioHdiRenderVolumeTest::handleSo = nullptr;
-#ifdef AUDIO_MPI_SO
-    int32_t (*AudioHdiRenderVolumeTest::SdkInit)() = nullptr;
-    void (*AudioHdiRenderVolumeTest::SdkExit)() = nullptr;
-    void *AudioHdiRenderVolumeTest::sdkSo = nullptr;
-#endif
+struct AudioStreamPool AudioHdiRenderVolumeTest::streamPool = {};
 
 void AudioHdiRenderVolumeTest::SetUpTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    char sdkResolvedPath[] = HDF_LIBRARY_FULL_PATH("libhdi_audio_interface_lib_render");
-    sdkSo = dlopen(sdkResolvedPath, RTLD_LAZY);
-    if (sdkSo == nullptr) {
-        return;
-    }
-    SdkInit = (int32_t (*)())(dlsym(sdkSo, "MpiSdkInit"));
-    if (SdkInit == nullptr) {
-        return;
-    }
-    SdkExit = (void (*)())(dlsym(sdkSo, "MpiSdkExit"));
-    if (SdkExit == nullptr) {
-        return;
-    }
-    SdkInit();
-#endif
-    char absPath[PATH_MAX] = {0};
-    if (realpath(RESOLVED_PATH.c_str(), absPath) == nullptr) {
-        return;
-    }
-    handleSo = dlopen(absPath, RTLD_LAZY);
-    if (handleSo == nullptr) {
-        return;
-    }
-    GetAudioManager = (TestAudioManager *(*)())(dlsym(handleSo, FUNCTION_NAME.c_str()));
+    GetAudioManager = AudioLoaderGetManagerFunc();
     if (GetAudioManager == nullptr) {
         return;
     }
+    (void)AdapterCacheRetain(GetAudioManager(), true);
+    StreamPoolInit(streamPool, GetAudioManager());
 }
 
 void AudioHdiRenderVolumeTest::TearDownTestCase(void)
 {
-#ifdef AUDIO_MPI_SO
-    SdkExit();
-    if (sdkSo != nullptr) {
-        dlclose(sdkSo);
-        sdkSo = nullptr;
-    }
-    if (SdkInit != nullptr) {
-        SdkInit = nullptr;
-    }
-    if (SdkExit != nullptr) {
-        SdkExit = nullptr;
-    }
-#endif
-    if (handleSo != nullptr) {
-        dlclose(handleSo);
-        handleSo = nullptr;
-    }
+    ReleaseControlSession();
+    StreamPoolDeinit(streamPool);
     if (GetAudioManager != nullptr) {
-        GetAudioManager = nullptr;
+        AdapterCacheRelease(GetAudioManager());
     }
+    GetAudioManager = nullptr;
 }
 
 void AudioHdiRenderVolumeTest::SetUp(void) {}
-void AudioHdiRenderVolumeTest::TearDown(void) {}
+void AudioHdiRenderVolumeTest::TearDown(void)
+{
+    StreamPoolReclaim(streamPool);
+}
 
 /**
 * @tc.name  Test RenderGetGainThreshold API via legal input
@@ -135,9 +95,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGainThreshold_0001, Fu
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.GetGainThreshold((AudioHandle)render, &min, &max);
@@ -145,8 +103,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGainThreshold_0001, Fu
     EXPECT_EQ(min, GAIN_MIN);
     EXPECT_EQ(max, GAIN_MAX);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGainThreshold API via set the parameter render to nullptr
@@ -161,16 +118,13 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGainThreshold_0002, Fu
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.GetGainThreshold((AudioHandle)renderNull, &min, &max);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGainThreshold API via set the parameter min to nullptr
@@ -184,16 +138,13 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGainThreshold_0003, Fu
     float *minNull = nullptr;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.GetGainThreshold((AudioHandle)render, minNull, &max);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGainThreshold API via set the parameter max to nullptr
@@ -207,15 +158,12 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGainThreshold_0004, Fu
     float *maxNull = nullptr;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetGainThreshold(render, &min, maxNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderSetGain API via legal input
@@ -229,9 +177,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0001, Function |
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetGainThreshold((AudioHandle)render, &min, &max);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -259,8 +205,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0001, Function |
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(gainMinExpc, gainMin);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderSetGain API via set gain to the boundary value
@@ -274,9 +219,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0002, Function |
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetGainThreshold((AudioHandle)render, &min, &max);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -289,8 +232,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0002, Function |
     ret = render->volume.SetGain(render, gainSec);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderSetGain API via set gain to exception type
@@ -303,16 +245,13 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0003, Function |
     char gain = 'a';
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetGain(render, gain);
     EXPECT_EQ(AUDIO_HAL_ERR_INTERNAL, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderSetGain API via set the parameter render to nullptr
@@ -326,16 +265,13 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderSetGain_0004, Function |
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetGain((AudioHandle)renderNull, gain);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGain API via legal input
@@ -349,9 +285,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0001, Function |
     float max = 0;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetGainThreshold((AudioHandle)render, &min, &max);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -365,8 +299,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0001, Function |
     EXPECT_EQ(gainValue, gain);
 
     render->control.Stop((AudioHandle)render);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGain API via set the parameter render to nullptr
@@ -380,15 +313,12 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0002, Function |
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.GetGain((AudioHandle)renderNull, &gain);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGain API via legal input in difference scenes
@@ -402,9 +332,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0003, Function |
     float gainOne = GAIN_MAX-1;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetGain(render, gain);
@@ -413,8 +341,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0003, Function |
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(gain, gainOne);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test RenderGetGain API via set the parameter gain to nullptr
@@ -427,14 +354,11 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_RenderGetGain_0004, Function |
     float *gainNull = nullptr;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetGain((AudioHandle)render, gainNull);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetMute API via legal input.
@@ -448,9 +372,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetMute_0001, Functi
     bool muteTrue = true;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetMute(render, muteFalse);
@@ -470,8 +392,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetMute_0001, Functi
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_FALSE(muteTrue);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetMute API via setting the incoming parameter render is empty .
@@ -485,14 +406,11 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetMute_0002, Functi
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.SetMute(renderNull, mute);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetMute API,when the parameter mutevalue equals 2.
@@ -505,9 +423,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetMute_0003, Functi
     bool muteValue = 2;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetMute(render, muteValue);
@@ -516,8 +432,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetMute_0003, Functi
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(true, muteValue);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderGetMute API via legal input.
@@ -532,9 +447,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetMute_0001, Functi
     bool defaultmute = true;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.GetMute(render, &muteTrue);
@@ -547,8 +460,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetMute_0001, Functi
     ret = render->volume.GetMute(render, &muteFalse);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_FALSE(muteFalse);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test interface AudioRenderGetMute when incoming parameter render is empty.
@@ -563,9 +475,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetMute_0002, Functi
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetMute(renderNull, &muteTrue);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
@@ -575,8 +485,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetMute_0002, Functi
 
     ret = render->volume.GetMute(render, nullptr);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetVolume API via legal input.
@@ -596,9 +505,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetVolume_0001, Func
     float volumeHighExpc = 0.80;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetVolume(render, volumeInit);
@@ -622,8 +529,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetVolume_0001, Func
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(volumeHighExpc, volumeHigh);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetVolume,when volume is set maximum value or minimum value.
@@ -641,9 +547,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetVolume_0002, Func
     float volumeMaxBoundary = 1.01;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.SetVolume(render, volumeMin);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
@@ -663,8 +567,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetVolume_0002, Func
     ret = render->volume.SetVolume(render, volumeMaxBoundary);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderSetVolume,when incoming parameter render is empty.
@@ -678,15 +581,12 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderSetVolume_0003, Func
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.SetVolume(renderNull, volume);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderGetVolume API via legal input.
@@ -700,9 +600,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetVolume_001, Funct
     float volumeDefault = 0.30;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetVolume(render, volume);
@@ -711,8 +609,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetVolume_001, Funct
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
     EXPECT_EQ(volumeDefault, volume);
 
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderGetVolume when when capturing is in progress.
@@ -726,9 +623,9 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetVolume_002, Funct
     float defaultVolume = 0.30;
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateStartRender(manager, &render, &adapter, ADAPTER_NAME);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = AudioRenderStartAndOneFrame(render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
 
     ret = render->volume.SetVolume(render, volume);
@@ -739,8 +636,7 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetVolume_002, Funct
 
     ret = render->control.Stop((AudioHandle)render);
     EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
 }
 /**
 * @tc.name  Test AudioRenderGetVolume,when incoming parameter render is empty.
@@ -754,13 +650,77 @@ HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderGetVolume_0003, Func
     struct AudioAdapter *adapter = nullptr;
     struct AudioRender *render = nullptr;
     struct AudioRender *renderNull = nullptr;
-    ASSERT_NE(nullptr, GetAudioManager);
-    TestAudioManager* manager = GetAudioManager();
-    ret = AudioCreateRender(manager, PIN_OUT_SPEAKER, ADAPTER_NAME, &adapter, &render);
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
     ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
     ret = render->volume.GetVolume(renderNull, &volume);
     EXPECT_EQ(AUDIO_HAL_ERR_INVALID_PARAM, ret);
-    adapter->DestroyRender(adapter, render);
-    manager->UnloadAdapter(manager, adapter);
+    StreamPoolReleaseRender(streamPool, adapter, render);
+}
+/**
+* @tc.name  Test AudioRenderSetVolume driven as a fast ramp during playback
+* @tc.number  SUB_Audio_HDI_AudioRenderVolumeRamp_0001
+* @tc.desc  Ramps the volume of a render playing a 1kHz tone 2000 times per second while a capture on the same
+*           adapter watches its envelope; returns 0 if every SetVolume succeeds. The envelope is only required
+*           never to step on a stand-in HAL, a device microphone does not hear the speaker reliably
+*/
+HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderVolumeRamp_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioRampParams params = {};
+    struct AudioRampReport report = {};
+    struct AudioAdapter *adapter = nullptr;
+    struct AudioAdapter *captureAdapter = nullptr;
+    struct AudioRender *render = nullptr;
+    struct AudioCapture *capture = nullptr;
+    ret = StreamPoolAcquireRender(streamPool, &adapter, &render);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+    ret = StreamPoolAcquireCapture(streamPool, &captureAdapter, &capture);
+    ASSERT_EQ(AUDIO_HAL_SUCCESS, ret);
+
+    RampParamsDefault(params, AUDIO_RAMP_VOLUME, 0.0, 1.0);
+    ret = RenderRampRun(render, capture, params, report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, ret);
+    RampReportPrint("render volume ramp", report);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, report.result);
+    EXPECT_EQ(AUDIO_HAL_SUCCESS, report.streamResult);
+    EXPECT_LT(INITIAL_VALUE, report.updates);
+    if (AudioLoaderOverridden()) {
+        EXPECT_EQ(INITIAL_VALUE, report.envelope.zipperSteps);
+    }
+
+    StreamPoolReleaseCapture(streamPool, captureAdapter, capture);
+    StreamPoolReleaseRender(streamPool, adapter, render);
+}
+#ifdef AUDIO_ADM_SO
+/**
+* @tc.name  Test the playback volume register via the shared control session
+* @tc.number  SUB_Audio_HDI_AudioRenderVolumeRegister_0001
+* @tc.desc  Reads the playback volume register, writes the value back and checks it, then rebinds the session
+*           after ReleaseControlSession; returns 0 if every access succeeds
+*/
+HWTEST_F(AudioHdiRenderVolumeTest, SUB_Audio_HDI_AudioRenderVolumeRegister_0001, Function | MediumTest | Level1)
+{
+    int32_t ret = -1;
+    struct AudioCtlElemValue elemValue = {};
+    struct AudioCtlElemValue reread = {};
+    /* a stand-in HAL has no ADM control service behind it */
+    if (AudioLoaderOverridden()) {
+        return;
+    }
+    elemValue.id.cardServiceName = CARD_SERVICE_NAME.c_str();
+    elemValue.id.iface = AUDIODRV_CTL_ELEM_IFACE_DAC;
+    elemValue.id.itemName = "Main Playback Volume";
+    ret = QueryRegisterStatus(elemValue.id, elemValue);
+    ASSERT_EQ(HDF_SUCCESS, ret);
+    ret = ChangeRegisterStatus(elemValue);
+    EXPECT_EQ(HDF_SUCCESS, ret);
+    ret = CheckRegisterStatus(elemValue.id, elemValue.id, elemValue.value[0], elemValue.value[0]);
+    EXPECT_EQ(HDF_SUCCESS, ret);
+
+    ReleaseControlSession();
+    ret = QueryRegisterStatus(elemValue.id, reread);
+    EXPECT_EQ(HDF_SUCCESS, ret);
+    EXPECT_EQ(elemValue.value[0], reread.value[0]);
+}
+#endif
 }
-}
\ No newline at end of file
@@ -41,7 +41,7 @@ void HdiCallbackTest::TearDown(void)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1001, Function | MediumTest | Level1)
 {
     Test_->Open();
-    Test_->onCameraStatusFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_CAMERA_STATUS);
     std::cout << "==========[test log]Preview stream, 640*480, expected success." << std::endl;
     // Start stream
     Test_->intents = {Camera::PREVIEW};
@@ -53,10 +53,11 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1001, Function | MediumTest | Level1)
     Test_->streamIds = {Test_->streamId_preview};
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->onCameraStatusFlag) {
+    bool signalled = Test_->EventSignalled(OHOS::Camera::Test::EVENT_CAMERA_STATUS);
+    if (signalled) {
         std::cout << "==========[test log]OnCameraStatus" << std::endl;
     }
-    EXPECT_EQ(Test_->onCameraStatusFlag, false);
+    EXPECT_EQ(signalled, false);
 }
 
 /**
@@ -68,18 +69,18 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1001, Function | MediumTest | Level1)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1002, Function | MediumTest | Level1)
 {
     Test_->GetCameraAbility();
-    Test_->onFlashlightStatusFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_FLASHLIGHT_STATUS);
     std::cout << "==========[test log]Turn on the flashlight, not the camera, success." << std::endl;
     Test_->status = true;
     Test_->rc = Test_->service->SetFlashlight(Test_->cameraIds.front(), Test_->status);
     EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
     Test_->status = false;
     Test_->rc = Test_->service->SetFlashlight(Test_->cameraIds.front(), Test_->status);
-    sleep(5);
-    if (Test_->onFlashlightStatusFlag) {
+    bool signalled = Test_->WaitEvent(OHOS::Camera::Test::EVENT_FLASHLIGHT_STATUS, Test_->EVENT_TIMEOUT_MS);
+    if (signalled) {
         std::cout << "==========[test log]OnFlashlightStatus" << std::endl;
     }
-    EXPECT_EQ(Test_->onFlashlightStatusFlag, true);
+    EXPECT_EQ(signalled, true);
 }
 
 /**
@@ -91,7 +92,7 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1002, Function | MediumTest | Level1)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1010, Function | MediumTest | Level1)
 {
     Test_->Open();
-    Test_->onErrorFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_DEVICE_ERROR);
     std::cout << "==========[test log]Preview stream, 640*480, expected success." << std::endl;
     // Start stream
     Test_->intents = {Camera::PREVIEW};
@@ -103,10 +104,11 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1010, Function | MediumTest | Level1)
     Test_->streamIds = {Test_->streamId_preview};
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->onErrorFlag) {
+    bool signalled = Test_->EventSignalled(OHOS::Camera::Test::EVENT_DEVICE_ERROR);
+    if (signalled) {
         std::cout << "==========[test log]OnError" << std::endl;
     }
-    EXPECT_EQ(Test_->onErrorFlag, false);
+    EXPECT_EQ(signalled, false);
 }
 
 /**
@@ -117,7 +119,7 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1010, Function | MediumTest | Level1)
   */
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1011, Function | MediumTest | Level1)
 {
-    Test_->onResultFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_RESULT);
     Test_->Open();
     EXPECT_EQ(true, Test_->cameraDevice != nullptr);
     std::cout << "==========[test log]Check hdi_device: SetResultMode is PER_FRAME." << std::endl;
@@ -138,10 +140,11 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1011, Function | MediumTest | Level1)
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->onResultFlag) {
+    bool signalled = Test_->WaitEvent(OHOS::Camera::Test::EVENT_RESULT, Test_->EVENT_TIMEOUT_MS);
+    if (signalled) {
         std::cout << "==========[test log]OnResult" << std::endl;
     }
-    EXPECT_EQ(Test_->onResultFlag, true);
+    EXPECT_EQ(signalled, true);
 }
 
 /**
@@ -153,7 +156,7 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1011, Function | MediumTest | Level1)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1020, Function | MediumTest | Level1)
 {
     Test_->Open();
-    Test_->captureStartFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_CAPTURE_STARTED);
     std::cout << "==========[test log]Preview stream, 640*480, expected success." << std::endl;
     // Start stream
     Test_->intents = {Camera::PREVIEW};
@@ -165,10 +168,11 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1020, Function | MediumTest | Level1)
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->captureStartFlag) {
+    bool signalled = Test_->WaitEvent(OHOS::Camera::Test::EVENT_CAPTURE_STARTED, Test_->EVENT_TIMEOUT_MS);
+    if (signalled) {
         std::cout << "==========[test log]OnCaptureStarted" << std::endl;
     }
-    EXPECT_EQ(Test_->captureStartFlag, true);
+    EXPECT_EQ(signalled, true);
 }
 
 /**
@@ -180,7 +184,7 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1020, Function | MediumTest | Level1)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1021, Function | MediumTest | Level1)
 {
     Test_->Open();
-    Test_->captureEndFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_CAPTURE_ENDED);
     std::cout << "==========[test log]Preview stream, 640*480, expected success." << std::endl;
     // Start stream
     Test_->intents = {Camera::PREVIEW};
@@ -192,10 +196,11 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1021, Function | MediumTest | Level1)
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->captureEndFlag) {
+    bool signalled = Test_->WaitEvent(OHOS::Camera::Test::EVENT_CAPTURE_ENDED, Test_->EVENT_TIMEOUT_MS);
+    if (signalled) {
         std::cout << "==========[test log]OnCaptureEnded" << std::endl;
     }
-    EXPECT_EQ(Test_->captureEndFlag, true);
+    EXPECT_EQ(signalled, true);
 }
 
 /**
@@ -218,7 +223,7 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1022, Function | MediumTest | Level1)
 HWTEST_F(HdiCallbackTest, Camera_Hdi_1023, Function | MediumTest | Level1)
 {
     Test_->Open();
-    Test_->frameShutterFlag = false;
+    Test_->ResetEvent(OHOS::Camera::Test::EVENT_FRAME_SHUTTER);
     std::cout << "==========[test log]Preview stream, 640*480, expected success." << std::endl;
     // Start stream
     Test_->intents = {Camera::PREVIEW};
@@ -230,8 +235,9 @@ HWTEST_F(HdiCallbackTest, Camera_Hdi_1023, Function | MediumTest | Level1)
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     Test_->StopConsumer(Test_->intents);
-    if (Test_->frameShutterFlag) {
+    bool signalled = Test_->WaitEvent(OHOS::Camera::Test::EVENT_FRAME_SHUTTER, Test_->EVENT_TIMEOUT_MS);
+    if (signalled) {
         std::cout << "==========[test log]OnFrameShutter" << std::endl;
     }
-    EXPECT_EQ(Test_->frameShutterFlag, true);
+    EXPECT_EQ(signalled, true);
 }
\ No newline at end of file
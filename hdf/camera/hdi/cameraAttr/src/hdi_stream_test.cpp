@@ -1296,7 +1296,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0191, TestSize.Level2)
     Test_->captureInfo->enableShutterCallback_ = true;
     Test_->rc = Test_->streamOperator->Capture(captureId, Test_->captureInfo, true);
     EXPECT_EQ(INVALID_ARGUMENT, Test_->rc);
-    sleep(1);
     Test_->streamOperator->CancelCapture(captureId);
     // release stream
     Test_->captureIds = {};
@@ -1357,7 +1356,7 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0192, TestSize.Level2)
     bool isStreaming = true;
     Test_->rc = Test_->streamOperator->Capture(captureId, Test_->captureInfo, isStreaming);
     EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
-    sleep(1);
+    EXPECT_NE(0U, consumer->WaitFirstArrival(Test_->EVENT_TIMEOUT_MS));
     Test_->streamOperator->CancelCapture(captureId);
 
     // release stream
@@ -1441,7 +1440,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0195, TestSize.Level2)
     int captureId = -1;
     Test_->rc = Test_->streamOperator->Capture(captureId, Test_->captureInfo, isStreaming);
     EXPECT_EQ(INVALID_ARGUMENT, Test_->rc);
-    sleep(1);
     // release stream
     Test_->rc = Test_->streamOperator->ReleaseStreams({ Test_->streamId_preview });
     EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
@@ -1816,7 +1814,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0230, TestSize.Level0)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // 3. Capture the camera stream, continuous shooting
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(1);
     // 4. Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     std::vector<int> offlineIds;
@@ -1837,8 +1834,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0230, TestSize.Level0)
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     // 6. Post-processing of offline streams
     Test_->cameraDevice->Close();
-    std::cout << "==========[test log] Pretend to wait 5s for callback..." << std::endl;
-    sleep(1);
     Test_->StopOfflineStream(Test_->captureId_capture);
     Test_->StopConsumer(Test_->intents);
 }
@@ -1860,7 +1855,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0231, TestSize.Level2)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, single capture
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(1);
     // Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     Test_->rc = Test_->streamOperator->ChangeToOfflineStream(
@@ -1897,7 +1891,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0232, TestSize.Level2)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, single capture
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(1);
     // Convert to offline stream
     Test_->offlineStreamOperatorCallback = nullptr;
     Test_->rc = Test_->streamOperator->ChangeToOfflineStream(
@@ -1934,7 +1927,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0241, TestSize.Level2)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // 3. Capture the camera stream, continuous shooting
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(1);
     // 4. Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     std::vector<int> offlineIds;
@@ -1955,8 +1947,6 @@ HWTEST_F(HdiStreamTest, Camera_Hdi_0241, TestSize.Level2)
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     // 6. Post-processing of offline streams
     Test_->cameraDevice->Close();
-    std::cout << "==========[test log] Pretend to wait 5s for callback..." << std::endl;
-    sleep(1);
 
     Test_->rc = Test_->offlineStreamOperator->CancelCapture(-1);
     EXPECT_EQ(Test_->rc, Camera::INVALID_ARGUMENT);
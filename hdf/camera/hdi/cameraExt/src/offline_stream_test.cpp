@@ -49,7 +49,6 @@ HWTEST_F(OfflineStreamTest, Camera_Offline_0001, TestSize.Level0)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, continuous capture
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(5);
     // Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     std::vector<int> offlineIds;
@@ -70,8 +69,6 @@ HWTEST_F(OfflineStreamTest, Camera_Offline_0001, TestSize.Level0)
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
     // Post-processing of offline streams
     Test_->cameraDevice->Close();
-    std::cout << "==========[test log]Check offline stream: Pretend to wait 5s for callback..." << std::endl;
-    sleep(1);
     Test_->StopOfflineStream(Test_->captureId_capture);
 }
 
@@ -92,7 +89,6 @@ HWTEST_F(OfflineStreamTest, Camera_Offline_0002, TestSize.Level2)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, continuous capture
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, true);
-    sleep(1);
     // Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     std::vector<int> offlineIds;
@@ -126,7 +122,6 @@ HWTEST_F(OfflineStreamTest, Camera_Offline_0003, TestSize.Level2)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, continuous capture
     Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
-    sleep(1);
     // Convert to offline stream
     Test_->CreateOfflineStreamOperatorCallback();
     std::vector<int> offlineIds;
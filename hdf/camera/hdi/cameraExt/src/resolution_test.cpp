@@ -123,7 +123,6 @@ HWTEST_F(ResolutionTest, Camera_Resolution_0001, TestSize.Level3)
     } else {
         std::cout << "==========[test log]CommitStreams fail, rc = " << Test_->rc << std::endl;
     }
-    sleep(2); // 2:The program waits two seconds
     std::vector<std::shared_ptr<Camera::StreamInfo>>().swap(Test_->streamInfos);
     // Capture preview stream
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
@@ -230,7 +229,6 @@ HWTEST_F(ResolutionTest, Camera_Resolution_0002, TestSize.Level3)
     } else {
         std::cout << "==========[test log]CommitStreams fail, rc = " << Test_->rc << std::endl;
     }
-    sleep(2); // 2:The program waits two seconds
     std::vector<std::shared_ptr<Camera::StreamInfo>>().swap(Test_->streamInfos);
     // Capture preview stream
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
@@ -337,7 +335,6 @@ HWTEST_F(ResolutionTest, Camera_Resolution_0003, TestSize.Level3)
     } else {
         std::cout << "==========[test log]CommitStreams fail, rc = " << Test_->rc << std::endl;
     }
-    sleep(2); // 2:The program waits two seconds
     std::vector<std::shared_ptr<Camera::StreamInfo>>().swap(Test_->streamInfos);
     // Capture preview stream
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
@@ -270,9 +270,7 @@ HWTEST_F(CaptureTest, Camera_Capture_0007, Function | MediumTest | Level1)
     Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
     // Capture the photo stream, multiple single capture
     Test_->StartCapture(Test_->streamId_capture, Test_->captureId_capture, false, false);
-    sleep(1);
     Test_->StartCapture(Test_->streamId_capture, (Test_->captureId_capture) + 1, false, false);
-    sleep(1);
     Test_->StartCapture(Test_->streamId_capture, (Test_->captureId_capture) + 2, false, false);
     // post-processing
     Test_->captureIds = {Test_->captureId_preview};
@@ -365,4 +363,36 @@ HWTEST_F(CaptureTest, Camera_Capture_0040, Function | MediumTest | Level2)
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->streamIds.push_back(Test_->streamId_capture);
     Test_->StopStream(Test_->captureIds, Test_->streamIds);
-}
\ No newline at end of file
+}
+
+/**
+  * @tc.name: preview and video
+  * @tc.desc: Preview and video streams requesting 30 fps, measure frame rate and intervals and judge dropped
+  *           frames against the requested frame duration.
+  * @tc.size: MediumTest
+  * @tc.type: Function
+  */
+HWTEST_F(CaptureTest, Camera_Capture_0050, Function | MediumTest | Level2)
+{
+    std::cout << "==========[test log]check Capture: Preview and video streams, frame pacing." << std::endl;
+    // Configure two streams of information
+    Test_->intents = {Camera::PREVIEW, Camera::VIDEO};
+    Test_->minFrameDuration = 33333333; // 33333333:30 fps
+    Test_->StartStream(Test_->intents);
+    Test_->StartCapture(Test_->streamId_preview, Test_->captureId_preview, false, true);
+    Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
+    // measure the steady state only, from the point both streams are running
+    Test_->ResetFramePacing();
+    sleep(5); // 5:measure five seconds of streaming
+    for (auto& intent : Test_->intents) {
+        OHOS::Camera::Test::FramePacing pacing = Test_->GetFramePacing(intent);
+        EXPECT_GT(pacing.frames, 1U);
+        EXPECT_TRUE(pacing.requested);
+        // no more than one frame in ten lost to late buffers
+        EXPECT_LE(pacing.droppedFrames * 10, pacing.frames); // 10:tolerated drop ratio
+    }
+    // post-processing
+    Test_->captureIds = {Test_->captureId_preview, Test_->captureId_video};
+    Test_->streamIds = {Test_->streamId_preview, Test_->streamId_video};
+    Test_->StopStream(Test_->captureIds, Test_->streamIds);
+}
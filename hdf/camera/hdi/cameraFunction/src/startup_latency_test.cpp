@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "startup_latency_test.h"
+
+using namespace OHOS;
+using namespace std;
+using namespace testing::ext;
+using namespace OHOS::Camera;
+
+namespace {
+const uint32_t STARTUP_COLD_RUNS = 5;
+const uint32_t STARTUP_WARM_RUNS = 5;
+const uint32_t FIRST_FRAME_TIMEOUT_MS = 5000;
+const double NS_PER_MS = 1000000.0; // 1000000.0:nanoseconds per millisecond
+const char* STARTUP_PHASE_NAMES[STARTUP_PHASE_COUNT] = {
+    "get host", "open camera", "get ability", "get stream operator", "create streams", "commit streams",
+    "capture", "first preview buffer", "first video buffer",
+};
+
+uint64_t NowNs()
+{
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+    return static_cast<uint64_t>(now.count());
+}
+
+std::shared_ptr<Camera::StreamInfo> StartupStreamInfo(int streamId, int32_t width, int32_t height,
+    Camera::StreamIntent intent, const std::shared_ptr<OHOS::Camera::Test::StreamConsumer>& consumer)
+{
+    std::shared_ptr<Camera::StreamInfo> info = std::make_shared<Camera::StreamInfo>();
+    info->streamId_ = streamId;
+    info->width_ = width;
+    info->height_ = height;
+#ifdef CAMERA_BUILT_ON_OHOS_LITE
+    info->format_ = IMAGE_PIXEL_FORMAT_NV21;
+#else
+    info->format_ = PIXEL_FMT_YCRCB_420_SP;
+#endif
+    info->datasapce_ = 8; // 8:datasapce of stream
+    info->intent_ = intent;
+    info->tunneledMode_ = 5; // 5:tunneledMode of stream
+    if (intent == Camera::VIDEO) {
+        info->encodeType_ = ENCODE_TYPE_H265;
+    }
+    // buffers are only timestamped, nothing is saved so storage stays out of the measurement
+    info->bufferQueue_ = consumer->CreateProducer(nullptr);
+    info->bufferQueue_->SetQueueSize(8); // 8:bufferqueue size
+    return info;
+}
+}
+
+void StartupLatencyTest::SetUpTestCase(void) {}
+void StartupLatencyTest::TearDownTestCase(void) {}
+void StartupLatencyTest::SetUp(void) {}
+void StartupLatencyTest::TearDown(void)
+{
+    StopStartup();
+}
+
+// walks Open to the first preview and video buffers with every HDI call timed, no fixed sleeps in between
+bool StartupLatencyTest::RunStartup(bool cold, StartupSample& sample)
+{
+    uint64_t start = NowNs();
+    uint64_t mark = start;
+    auto endPhase = [&sample, &mark](StartupPhase phase) {
+        uint64_t now = NowNs();
+        sample.phaseNs[phase] = now - mark;
+        mark = now;
+    };
+    if (cold) {
+        Test_ = std::make_shared<OHOS::Camera::Test>();
+        Test_->Init();
+    }
+    if (Test_ == nullptr || Test_->service == nullptr) {
+        return false;
+    }
+    endPhase(STARTUP_GET_HOST);
+
+    Test_->service->GetCameraIds(Test_->cameraIds);
+    if (Test_->cameraIds.empty()) {
+        std::cout << "==========[test log]GetCameraIds returned no camera." << std::endl;
+        return false;
+    }
+#ifdef CAMERA_BUILT_ON_OHOS_LITE
+    Test_->deviceCallback = std::make_shared<HdiDeviceCallback>(Test_.get());
+#else
+    Test_->deviceCallback = new HdiDeviceCallback(Test_.get());
+#endif
+    Test_->rc = Test_->service->OpenCamera(Test_->cameraIds.front(), Test_->deviceCallback, Test_->cameraDevice);
+    EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+    if (Test_->rc != Camera::NO_ERROR || Test_->cameraDevice == nullptr) {
+        return false;
+    }
+    endPhase(STARTUP_OPEN_CAMERA);
+    Test_->rc = Test_->service->GetCameraAbility(Test_->cameraIds.front(), Test_->ability);
+    EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+    endPhase(STARTUP_GET_ABILITY);
+
+    Test_->CreateStreamOperatorCallback();
+    Test_->rc = Test_->cameraDevice->GetStreamOperator(Test_->streamOperatorCallback, Test_->streamOperator);
+    EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+    if (Test_->rc != Camera::NO_ERROR || Test_->streamOperator == nullptr) {
+        return false;
+    }
+    endPhase(STARTUP_GET_STREAM_OPERATOR);
+
+    std::shared_ptr<OHOS::Camera::Test::StreamConsumer> preview =
+        std::make_shared<OHOS::Camera::Test::StreamConsumer>();
+    std::shared_ptr<OHOS::Camera::Test::StreamConsumer> video =
+        std::make_shared<OHOS::Camera::Test::StreamConsumer>();
+    Test_->consumerMap_[Camera::PREVIEW] = preview;
+    Test_->consumerMap_[Camera::VIDEO] = video;
+    Test_->streamInfos.push_back(StartupStreamInfo(Test_->streamId_preview, 640, 480, // 640, 480:preview size
+        Camera::PREVIEW, preview));
+    Test_->streamInfos.push_back(StartupStreamInfo(Test_->streamId_video, 1280, 960, // 1280, 960:video size
+        Camera::VIDEO, video));
+    Test_->rc = Test_->streamOperator->CreateStreams(Test_->streamInfos);
+    std::vector<std::shared_ptr<Camera::StreamInfo>>().swap(Test_->streamInfos);
+    EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+    if (Test_->rc != Camera::NO_ERROR) {
+        return false;
+    }
+    Test_->streamIds = {Test_->streamId_preview, Test_->streamId_video};
+    endPhase(STARTUP_CREATE_STREAMS);
+    Test_->rc = Test_->streamOperator->CommitStreams(Camera::NORMAL, Test_->ability);
+    EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+    if (Test_->rc != Camera::NO_ERROR) {
+        return false;
+    }
+    endPhase(STARTUP_COMMIT_STREAMS);
+
+    auto capture = [this](int streamId, int captureId) {
+        uint64_t issued = NowNs();
+        Test_->captureInfo = std::make_shared<Camera::CaptureInfo>();
+        Test_->captureInfo->streamIds_.push_back(streamId);
+        Test_->captureInfo->captureSetting_ = Test_->ability;
+        Test_->captureInfo->enableShutterCallback_ = false;
+        Test_->rc = Test_->streamOperator->Capture(captureId, Test_->captureInfo, true);
+        EXPECT_EQ(Test_->rc, Camera::NO_ERROR);
+        if (Test_->rc == Camera::NO_ERROR) {
+            Test_->captureIds.push_back(captureId);
+        }
+        return issued;
+    };
+    uint64_t previewIssued = capture(Test_->streamId_preview, Test_->captureId_preview);
+    uint64_t videoIssued = capture(Test_->streamId_video, Test_->captureId_video);
+    endPhase(STARTUP_CAPTURE);
+
+    uint64_t previewFirst = preview->WaitFirstArrival(FIRST_FRAME_TIMEOUT_MS);
+    uint64_t videoFirst = video->WaitFirstArrival(FIRST_FRAME_TIMEOUT_MS);
+    EXPECT_NE(previewFirst, 0U);
+    EXPECT_NE(videoFirst, 0U);
+    if (previewFirst == 0 || videoFirst == 0) {
+        return false;
+    }
+    sample.phaseNs[STARTUP_FIRST_PREVIEW] = previewFirst - previewIssued;
+    sample.phaseNs[STARTUP_FIRST_VIDEO] = videoFirst - videoIssued;
+    sample.totalNs = std::max(previewFirst, videoFirst) - start;
+    sample.complete = true;
+    return true;
+}
+
+// releases whatever RunStartup got to and closes the camera, keeping the host for the next warm run
+void StartupLatencyTest::StopStartup()
+{
+    if (Test_ == nullptr) {
+        return;
+    }
+    if (Test_->streamOperator != nullptr) {
+        for (auto& captureId : Test_->captureIds) {
+            Test_->streamOperator->CancelCapture(captureId);
+        }
+        if (!Test_->streamIds.empty()) {
+            Test_->streamOperator->ReleaseStreams(Test_->streamIds);
+        }
+    }
+    Test_->captureIds.clear();
+    Test_->streamIds.clear();
+    for (auto& it : Test_->consumerMap_) {
+        it.second->StopConsumer();
+    }
+    Test_->consumerMap_.clear();
+    Test_->streamOperator = nullptr;
+    Test_->Close();
+    Test_->captureId_preview++;
+    Test_->captureId_video++;
+}
+
+void StartupLatencyTest::ReportStartup(const char* name, const std::vector<StartupSample>& samples)
+{
+    std::cout << "==========[test log]startup latency, " << name << ": " << samples.size() << " runs" << std::endl;
+    if (samples.empty()) {
+        return;
+    }
+    // one row per phase, then the whole run from the first call to the last first buffer
+    for (uint32_t phase = 0; phase <= STARTUP_PHASE_COUNT; phase++) {
+        uint64_t minNs = UINT64_MAX;
+        uint64_t maxNs = 0;
+        uint64_t sumNs = 0;
+        for (auto& sample : samples) {
+            uint64_t ns = phase < STARTUP_PHASE_COUNT ? sample.phaseNs[phase] : sample.totalNs;
+            minNs = std::min(minNs, ns);
+            maxNs = std::max(maxNs, ns);
+            sumNs += ns;
+        }
+        std::cout << "    " << (phase < STARTUP_PHASE_COUNT ? STARTUP_PHASE_NAMES[phase] : "open to first buffers") <<
+            ": min " << minNs / NS_PER_MS << " ms, mean " << sumNs / samples.size() / NS_PER_MS << " ms, max " <<
+            maxNs / NS_PER_MS << " ms" << std::endl;
+    }
+}
+
+/**
+  * @tc.name: startup latency
+  * @tc.desc: Cold start, acquire the host and open the camera from scratch up to the first preview and video buffers.
+  * @tc.size: MediumTest
+  * @tc.type: Function
+  */
+HWTEST_F(StartupLatencyTest, Camera_Startup_0001, Function | MediumTest | Level2)
+{
+    std::cout << "==========[test log]Startup latency: cold open to the first preview and video buffers." << std::endl;
+    std::vector<StartupSample> samples;
+    for (uint32_t i = 0; i < STARTUP_COLD_RUNS; i++) {
+        StartupSample sample;
+        bool complete = RunStartup(true, sample);
+        EXPECT_TRUE(complete);
+        StopStartup();
+        if (complete) {
+            samples.push_back(sample);
+        }
+    }
+    ReportStartup("cold", samples);
+}
+
+/**
+  * @tc.name: startup latency
+  * @tc.desc: Warm start, reopen the camera on a host that has already streamed, up to the first buffers.
+  * @tc.size: MediumTest
+  * @tc.type: Function
+  */
+HWTEST_F(StartupLatencyTest, Camera_Startup_0002, Function | MediumTest | Level2)
+{
+    std::cout << "==========[test log]Startup latency: warm open to the first preview and video buffers." << std::endl;
+    Test_ = std::make_shared<OHOS::Camera::Test>();
+    Test_->Init();
+    // one untimed pass so the pipeline has been built once before the measured runs
+    StartupSample prime;
+    EXPECT_TRUE(RunStartup(false, prime));
+    StopStartup();
+    std::vector<StartupSample> samples;
+    for (uint32_t i = 0; i < STARTUP_WARM_RUNS; i++) {
+        StartupSample sample;
+        bool complete = RunStartup(false, sample);
+        EXPECT_TRUE(complete);
+        StopStartup();
+        if (complete) {
+            samples.push_back(sample);
+        }
+    }
+    ReportStartup("warm", samples);
+}
@@ -51,7 +51,8 @@ HWTEST_F(VideoTest, Camera_Video_0001, TestSize.Level0)
     // Capture video stream
     Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
     // Post-processing
-    sleep(5);
+    // record about a second of video instead of sleeping
+    EXPECT_EQ(true, Test_->WaitBuffers(Test_->streamId_video, 30, Test_->EVENT_TIMEOUT_MS)); // 30:video frames
     Test_->captureIds = {Test_->captureId_preview, Test_->captureId_video};
     Test_->streamIds.push_back(Test_->streamId_preview);
     Test_->streamIds.push_back(Test_->streamId_video);
@@ -86,7 +87,8 @@ HWTEST_F(VideoTest, Camera_Video_0002, TestSize.Level1)
     }
     // Capture video stream
     Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
-    sleep(5);
+    // record about a second of video instead of sleeping
+    EXPECT_EQ(true, Test_->WaitBuffers(Test_->streamId_video, 30, Test_->EVENT_TIMEOUT_MS)); // 30:video frames
     // Post-processing
     Test_->captureIds = {Test_->captureId_preview, Test_->captureId_video};
     Test_->streamIds = {Test_->streamId_preview, Test_->streamId_video};
@@ -247,7 +249,8 @@ HWTEST_F(VideoTest, Camera_Video_0021, TestSize.Level1)
     }
     // Capture preview stream
     Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
-    sleep(5);
+    // record about a second of video instead of sleeping
+    EXPECT_EQ(true, Test_->WaitBuffers(Test_->streamId_video, 30, Test_->EVENT_TIMEOUT_MS)); // 30:video frames
     // Post-processing
     Test_->captureIds = {Test_->captureId_preview, Test_->captureId_video};
     Test_->streamIds = {Test_->streamId_preview, Test_->streamId_video};
@@ -283,7 +286,8 @@ HWTEST_F(VideoTest, Camera_Video_0022, TestSize.Level2)
     }
     // Capture video stream
     Test_->StartCapture(Test_->streamId_video, Test_->captureId_video, false, true);
-    sleep(5);
+    // record about a second of video instead of sleeping
+    EXPECT_EQ(true, Test_->WaitBuffers(Test_->streamId_video, 30, Test_->EVENT_TIMEOUT_MS)); // 30:video frames
     // Post-processing
     Test_->captureIds = {Test_->captureId_preview, Test_->captureId_video};
     Test_->streamIds = {Test_->streamId_preview, Test_->streamId_video};
@@ -70,63 +70,164 @@ int32_t Test::SaveYUV(const char* type, const void* buffer, int32_t size)
             return 0;
         }
     }
-    char path[PATH_MAX] = {0};
-#ifdef CAMERA_BUILT_ON_OHOS_LITE
-    if (strncmp(type, "preview", strlen(type)) == 0) {
-        system("mkdir -p /userdata/camera");
-        char prefix[] = "/userdata/camera/";
+    return frameDumper_->Enqueue(type, buffer, size);
+}
 
-        if (sprintf_s(path, sizeof(path) / sizeof(path[0]), "%s%s_%lld.yuv",
-            prefix, type, GetCurrentLocalTimeStamp()) < 0) {
-            CAMERA_LOGE("%s: sprintf path failed", __func__);
-            return 0;
+static int MakeDirectory(const std::string& path)
+{
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        if (mkdir(path.substr(0, pos).c_str(), 00755) == -1 && errno != EEXIST) { // 00755:directory jurisdiction
+            std::cout << "mkdir " << path.substr(0, pos) << " failed, errno = " << strerror(errno) << std::endl;
+            return -1;
         }
-    } else {
-        system("mkdir -p /userdata/camera");
-        char prefix[] = "/userdata/camera/";
+    }
+    return 0;
+}
 
-        if (sprintf_s(path, sizeof(path) / sizeof(path[0]), "%s%s_%lld.jpg",
-            prefix, type, GetCurrentLocalTimeStamp()) < 0) {
-            CAMERA_LOGE("%s: sprintf path failed", __func__);
-            return 0;
+static bool WriteAll(int fd, const uint8_t* data, size_t size)
+{
+    while (size > 0) {
+        ssize_t ret = write(fd, data, size);
+        if (ret == -1 && errno == EINTR) {
+            continue;
         }
+        if (ret == -1) {
+            std::cout << "write file failed, error = " << strerror(errno) << std::endl;
+            return false;
+        }
+        data += ret;
+        size -= static_cast<size_t>(ret);
     }
-#else
-    if (strncmp(type, "preview", strlen(type)) == 0) {
-        system("mkdir -p /data/camera/preview");
-        char prefix[] = "/data/camera/preview/";
+    return true;
+}
 
-        if (sprintf_s(path, sizeof(path) / sizeof(path[0]), "%s%s_%lld.yuv",
-            prefix, type, GetCurrentLocalTimeStamp()) < 0) {
-            CAMERA_LOGE("%s: sprintf path failed", __func__);
-            return 0;
+Test::FrameDumper::~FrameDumper()
+{
+    {
+        std::unique_lock<std::mutex> l(lock_);
+        stopping_ = true;
+        cv_.notify_all();
+    }
+    if (writer_ != nullptr) {
+        writer_->join();
+        delete writer_;
+    }
+    for (auto& it : fds_) {
+        if (it.second != -1) {
+            close(it.second);
         }
-    } else {
-        system("mkdir -p /data/camera/capture");
-        char prefix[] = "/data/camera/capture/";
+    }
+    if (written_ != 0 || dropped_ != 0) {
+        std::cout << "frame dump: written " << written_ << ", dropped " << dropped_ << std::endl;
+    }
+}
 
-        if (sprintf_s(path, sizeof(path) / sizeof(path[0]), "%s%s_%lld.jpg",
-            prefix, type, GetCurrentLocalTimeStamp()) < 0) {
-            CAMERA_LOGE("%s: sprintf path failed", __func__);
-            return 0;
+int32_t Test::FrameDumper::Enqueue(const char* type, const void* buffer, int32_t size)
+{
+    if (type == nullptr || buffer == nullptr || size <= 0) {
+        return -1;
+    }
+    Frame* frame = nullptr;
+    {
+        std::unique_lock<std::mutex> l(lock_);
+        if (writer_ == nullptr) {
+            for (uint32_t i = 0; i < QUEUE_DEPTH; i++) {
+                slots_.push_back(std::make_unique<Frame>());
+                free_.push_back(slots_.back().get());
+            }
+            writer_ = new std::thread([this] { WriteLoop(); });
+        }
+        if (free_.empty()) {
+            dropped_++;
+            return -1;
+        }
+        frame = free_.back();
+        free_.pop_back();
+    }
+    // the consumer releases the surface buffer as soon as its callback returns, so the frame is copied
+    const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+    frame->type = type;
+    frame->data.assign(bytes, bytes + size);
+    std::unique_lock<std::mutex> l(lock_);
+    queue_.push_back(frame);
+    cv_.notify_one();
+    return 0;
+}
+
+void Test::FrameDumper::Flush()
+{
+    std::unique_lock<std::mutex> l(lock_);
+    idleCv_.wait(l, [this] { return queue_.empty() && !writing_; });
+}
+
+void Test::FrameDumper::WriteLoop()
+{
+    std::unique_lock<std::mutex> l(lock_);
+    while (true) {
+        cv_.wait(l, [this] { return !queue_.empty() || stopping_; });
+        if (queue_.empty()) {
+            break;
+        }
+        Frame* frame = queue_.front();
+        queue_.pop_front();
+        writing_ = true;
+        l.unlock();
+        bool still = frame->type == "capture";
+        int fd = still ? OpenOutput(frame->type) : OutputFd(frame->type);
+        bool saved = fd != -1 && WriteAll(fd, frame->data.data(), frame->data.size());
+        if (still && fd != -1) {
+            close(fd);
+        }
+        l.lock();
+        if (saved) {
+            written_++;
+        } else {
+            dropped_++;
+        }
+        free_.push_back(frame);
+        writing_ = false;
+        if (queue_.empty()) {
+            idleCv_.notify_all();
         }
     }
+}
+
+// stills are complete JPEG images, so each one gets a file of its own; any other type is raw YUV and is
+// appended to one file per type for the life of the dumper
+int Test::FrameDumper::OpenOutput(const std::string& type)
+{
+    bool still = type == "capture";
+#ifdef CAMERA_BUILT_ON_OHOS_LITE
+    std::string dir = "/userdata/camera/";
+#else
+    std::string dir = still ? "/data/camera/capture/" : "/data/camera/preview/";
 #endif
-    std::cout << "save yuv to file:" << path << std::endl;
-    int imgFd = open(path, O_RDWR | O_CREAT | O_APPEND, 00766); // 00766:file jurisdiction
-    if (imgFd == -1) {
-        std::cout << "open file failed, errno = " << strerror(errno) << std::endl;
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    std::string path = dir + type + "_" + std::to_string(now.count()) +
+        (still ? "_" + std::to_string(stills_++) + ".jpg" : ".yuv");
+    if (MakeDirectory(dir) != 0) {
         return -1;
     }
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | (still ? O_TRUNC : O_APPEND), 00766); // 00766:file jurisdiction
+    if (fd == -1) {
+        std::cout << "open file failed, errno = " << strerror(errno) << std::endl;
+    } else if (!still) {
+        std::cout << "save yuv to file:" << path << std::endl;
+    }
+    return fd;
+}
 
-    int32_t ret = write(imgFd, buffer, size);
-    if (ret == -1) {
-        std::cout << "write file failed, error = " << strerror(errno) << std::endl;
-        close(imgFd);
-        return -1;
+int Test::FrameDumper::OutputFd(const std::string& type)
+{
+    auto it = fds_.find(type);
+    if (it != fds_.end()) {
+        return it->second;
     }
-    close(imgFd);
-    return 0;
+    // a directory or file that cannot be created is not retried for every frame
+    int fd = OpenOutput(type);
+    fds_[type] = fd;
+    return fd;
 }
 
 int32_t Test::SaveVideoFile(const char* type, const void* buffer, int32_t size, int32_t operationMode)
@@ -253,6 +354,7 @@ void Test::Open()
 
 void Test::Close()
 {
+    frameDumper_->Flush();
     if (cameraDevice != nullptr) {
         cameraDevice->Close();
         std::cout << "cameraDevice->Close" << std::endl;
@@ -282,6 +384,7 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
             streamInfo->datasapce_ = 8; // 8:datasapce of stream
             streamInfo->intent_ = intent;
             streamInfo->tunneledMode_ = 5; // 5:tunneledMode of stream
+            streamInfo->minFrameDuration_ = minFrameDuration;
             StreamInfoFormat();
             std::shared_ptr<StreamConsumer> consumer_pre = std::make_shared<StreamConsumer>();
             std::cout << "==========[test log]received a preview buffer ... 0" << std::endl;
@@ -296,6 +399,7 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
 #endif
             streamInfo->bufferQueue_->SetQueueSize(8); // 8:bufferqueue size
             consumerMap_[intent] = consumer_pre;
+            frameDurationMap_[intent] = static_cast<uint64_t>(std::max(streamInfo->minFrameDuration_, 0));
             streamInfos.push_back(streamInfo);
         } else if (intent == 1) {
             streamInfo_video->streamId_ = streamId_video;
@@ -305,6 +409,7 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
             streamInfo_video->intent_ = intent;
             streamInfo_video->encodeType_ = ENCODE_TYPE_H265;
             streamInfo_video->tunneledMode_ = 5; // 5:tunneledMode of stream
+            streamInfo_video->minFrameDuration_ = minFrameDuration;
 #ifdef CAMERA_BUILT_ON_OHOS_LITE
             streamInfo_video->format_ = IMAGE_PIXEL_FORMAT_NV21;
 #else
@@ -326,6 +431,7 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
 #endif
             streamInfo_video->bufferQueue_->SetQueueSize(8); // 8:bufferqueue size
             consumerMap_[intent] = consumer_video;
+            frameDurationMap_[intent] = static_cast<uint64_t>(std::max(streamInfo_video->minFrameDuration_, 0));
             streamInfos.push_back(streamInfo_video);
         } else {
             streamInfo_capture->streamId_ = streamId_capture;
@@ -353,6 +459,7 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
 #endif
             streamInfo_capture->bufferQueue_->SetQueueSize(8); // 8:bufferqueue size
             consumerMap_[intent] = consumer_capture;
+            frameDurationMap_[intent] = static_cast<uint64_t>(std::max(streamInfo_capture->minFrameDuration_, 0));
             streamInfos.push_back(streamInfo_capture);
         }
     }
@@ -371,7 +478,6 @@ void Test::StartStream(std::vector<Camera::StreamIntent> intents)
     } else {
         std::cout << "==========[test log]CommitStreams fail, rc = " << rc << std::endl;
     }
-    sleep(2); // 2:The program waits two seconds
     std::vector<std::shared_ptr<Camera::StreamInfo>>().swap(streamInfos);
 }
 
@@ -381,18 +487,73 @@ void Test::StartCapture(int streamId, int captureId, bool shutterCallback, bool
     captureInfo->streamIds_.push_back(streamId);
     captureInfo->captureSetting_ = ability;
     captureInfo->enableShutterCallback_ = shutterCallback;
+    std::shared_ptr<StreamConsumer> consumer = StreamConsumerOf(streamId);
+    size_t arrived = consumer != nullptr ? consumer->ArrivalCount() : 0;
     rc = streamOperator->Capture(captureId, captureInfo, isStreaming);
     EXPECT_EQ(true, rc == Camera::NO_ERROR);
     if (rc == Camera::NO_ERROR) {
         std::cout << "==========[test log]check Capture: Capture success, " << captureId << std::endl;
     } else {
         std::cout << "==========[test log]check Capture: Capture fail, rc = " << rc << std::endl;
+        return;
+    }
+    // return once the capture has produced a buffer, not after a fixed time
+    if (consumer != nullptr) {
+        EXPECT_EQ(true, consumer->WaitArrivals(arrived + 1, EVENT_TIMEOUT_MS));
     }
-    sleep(1); // 1:Wait 1 second for the program to run
+}
+
+std::shared_ptr<Test::StreamConsumer> Test::StreamConsumerOf(int streamId)
+{
+    OHOS::Camera::StreamIntent intent = Camera::PREVIEW;
+    if (streamId == streamId_video) {
+        intent = Camera::VIDEO;
+    } else if (streamId == streamId_capture) {
+        intent = Camera::STILL_CAPTURE;
+    } else if (streamId != streamId_preview) {
+        return nullptr;
+    }
+    auto it = consumerMap_.find(intent);
+    return it != consumerMap_.end() ? it->second : nullptr;
+}
+
+bool Test::WaitBuffers(int streamId, uint32_t count, uint32_t timeoutMs)
+{
+    std::shared_ptr<StreamConsumer> consumer = StreamConsumerOf(streamId);
+    if (consumer == nullptr) {
+        return false;
+    }
+    return consumer->WaitArrivals(consumer->ArrivalCount() + count, timeoutMs);
+}
+
+void Test::SignalEvent(CameraEvent event)
+{
+    std::unique_lock<std::mutex> l(events_[event].lock_);
+    events_[event].signalled_ = true;
+    events_[event].cv_.notify_all();
+}
+
+void Test::ResetEvent(CameraEvent event)
+{
+    std::unique_lock<std::mutex> l(events_[event].lock_);
+    events_[event].signalled_ = false;
+}
+
+bool Test::EventSignalled(CameraEvent event)
+{
+    return events_[event].signalled_;
+}
+
+bool Test::WaitEvent(CameraEvent event, uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> l(events_[event].lock_);
+    return events_[event].cv_.wait_for(l, std::chrono::milliseconds(timeoutMs),
+        [this, event] { return events_[event].signalled_.load(); });
 }
 
 void Test::StopStream(std::vector<int>& captureIds, std::vector<int>& streamIds)
 {
+    ReportFramePacing();
     if (captureIds.size() > 0) {
         std::cout << "captureIds.size() = " << captureIds.size() << std::endl;
         for (auto &captureId : captureIds) {
@@ -434,6 +595,81 @@ void Test::StopConsumer(std::vector<Camera::StreamIntent> intents)
     }
 }
 
+void Test::ResetFramePacing()
+{
+    for (auto& it : consumerMap_) {
+        if (it.second != nullptr) {
+            it.second->ResetArrivals();
+        }
+    }
+}
+
+Test::FramePacing Test::GetFramePacing(OHOS::Camera::StreamIntent intent)
+{
+    FramePacing pacing;
+    auto duration = frameDurationMap_.find(intent);
+    pacing.requested = duration != frameDurationMap_.end() && duration->second != 0;
+    pacing.expectedIntervalNs = pacing.requested ? duration->second : FramePacing::DEFAULT_INTERVAL_NS;
+    pacing.histogram.assign(FramePacing::BUCKETS_PER_INTERVAL * FramePacing::HISTOGRAM_INTERVALS + 1, 0);
+    auto consumer = consumerMap_.find(intent);
+    if (consumer == consumerMap_.end() || consumer->second == nullptr) {
+        return pacing;
+    }
+    std::vector<uint64_t> arrivals = consumer->second->GetArrivals();
+    pacing.frames = arrivals.size();
+    if (arrivals.size() < 2) { // 2:an interval needs two frames
+        return pacing;
+    }
+    pacing.minIntervalNs = UINT64_MAX;
+    for (size_t i = 1; i < arrivals.size(); i++) {
+        uint64_t interval = arrivals[i] - arrivals[i - 1];
+        pacing.minIntervalNs = std::min(pacing.minIntervalNs, interval);
+        pacing.maxIntervalNs = std::max(pacing.maxIntervalNs, interval);
+        uint64_t bucket = interval * FramePacing::BUCKETS_PER_INTERVAL / pacing.expectedIntervalNs;
+        pacing.histogram[std::min<uint64_t>(bucket, pacing.histogram.size() - 1)]++;
+        // an interval of n expected intervals, rounded, means n - 1 frames never arrived
+        uint64_t slots = (interval + pacing.expectedIntervalNs / 2) / pacing.expectedIntervalNs; // 2:round
+        if (slots > 1) {
+            pacing.droppedFrames += slots - 1;
+        }
+    }
+    uint64_t span = arrivals.back() - arrivals.front();
+    pacing.meanIntervalNs = span / (arrivals.size() - 1);
+    if (span != 0) {
+        const double nsPerSec = 1000000000.0; // 1000000000.0:nanoseconds per second
+        pacing.fps = static_cast<double>(arrivals.size() - 1) * nsPerSec / span;
+    }
+    return pacing;
+}
+
+void Test::ReportFramePacing()
+{
+    const double nsPerMs = 1000000.0; // 1000000.0:nanoseconds per millisecond
+    for (auto& it : consumerMap_) {
+        FramePacing pacing = GetFramePacing(it.first);
+        std::cout << "==========[test log]frame pacing intent " << it.first << ": frames " << pacing.frames <<
+            ", fps " << pacing.fps << ", interval mean " << pacing.meanIntervalNs / nsPerMs << " ms min " <<
+            pacing.minIntervalNs / nsPerMs << " ms max " << pacing.maxIntervalNs / nsPerMs << " ms, expected " <<
+            pacing.expectedIntervalNs / nsPerMs << (pacing.requested ? " ms" : " ms assumed") << ", dropped " <<
+            pacing.droppedFrames << std::endl;
+        if (pacing.frames < 2) { // 2:no intervals to show
+            continue;
+        }
+        for (size_t i = 0; i < pacing.histogram.size(); i++) {
+            if (pacing.histogram[i] == 0) {
+                continue;
+            }
+            std::cout << "    " << static_cast<double>(i) / FramePacing::BUCKETS_PER_INTERVAL << "x";
+            if (i + 1 < pacing.histogram.size()) {
+                std::cout << " - " << static_cast<double>(i + 1) / FramePacing::BUCKETS_PER_INTERVAL << "x";
+            } else {
+                std::cout << " and longer";
+            }
+            std::cout << ": " << pacing.histogram[i] << std::endl;
+        }
+    }
+}
+
 void Test::StopOfflineStream(int captureId)
 {
     captureId--;
@@ -458,16 +694,20 @@ void Test::StopOfflineStream(int captureId)
 std::shared_ptr<OHOS::Surface> Test::StreamConsumer::CreateProducer(std::function<void(OHOS::SurfaceBuffer*)> callback)
 {
     Surface* surface = OHOS::Surface::CreateSurface();
-    consumer_ = std::shared_ptr<OHOS::Surface>(surface);
-    if (consumer_ == nullptr) {
+    if (surface == nullptr) {
         return nullptr;
     }
+    // the surface only references its listener, so keep the listener until the last owner drops the surface
+    auto listener = std::make_shared<TestBufferConsumerListener>(signal_);
+    consumer_ = std::shared_ptr<OHOS::Surface>(surface, [listener](OHOS::Surface* s) { delete s; });
+    consumer_->RegisterConsumerListener(*listener);
     callback_ = callback;
 
     consumerThread_ = new std::thread([this] {
-        while (running_ == true) {
+        while (WaitBufferAvailable()) {
             OHOS::SurfaceBuffer* buffer = consumer_->AcquireBuffer();
             if (buffer != nullptr) {
+                RecordArrival();
                 if (callback_ != nullptr) {
                     callback_(buffer);
                 }
@@ -484,7 +724,7 @@ OHOS::sptr<OHOS::IBufferProducer> Test::StreamConsumer::CreateProducer(std::func
     if (consumer_ == nullptr) {
         return nullptr;
     }
-    sptr<IBufferConsumerListener> listener = new TestBufferConsumerListener();
+    sptr<IBufferConsumerListener> listener = new TestBufferConsumerListener(signal_);
     consumer_->RegisterConsumerListener(listener);
     auto producer = consumer_->GetProducer();
     std::cout << "create a buffer queue producer:" << producer.GetRefPtr() << std::endl;
@@ -492,16 +732,21 @@ OHOS::sptr<OHOS::IBufferProducer> Test::StreamConsumer::CreateProducer(std::func
         return nullptr;
     }
     callback_ = callback;
-    running_ = true;
+    {
+        std::unique_lock<std::mutex> l(signal_->lock_);
+        running_ = true;
+        signal_->stopped_ = false;
+    }
     consumerThread_ = new std::thread([this] {
         int32_t flushFence = 0;
         int64_t timestamp = 0;
         OHOS::Rect damage;
         OHOS::BufferRequestConfig config;
-        while (running_ == true) {
+        while (WaitBufferAvailable()) {
             OHOS::sptr<OHOS::SurfaceBuffer> buffer = nullptr;
             consumer_->AcquireBuffer(buffer, flushFence, timestamp, damage);
             if (buffer != nullptr) {
+                RecordArrival();
                 void* addr = buffer->GetVirAddr();
                 uint32_t size = buffer->GetSize();
                 uint64_t pa = buffer->GetPhyAddr();
@@ -517,9 +762,6 @@ OHOS::sptr<OHOS::IBufferProducer> Test::StreamConsumer::CreateProducer(std::func
                     cv_.notify_one();
                 }
             }
-            if (running_ == false) {
-                break;
-            }
         }
         return;
     });
@@ -527,8 +769,73 @@ OHOS::sptr<OHOS::IBufferProducer> Test::StreamConsumer::CreateProducer(std::func
 }
 #endif
 
+void Test::TestBufferConsumerListener::OnBufferAvailable()
+{
+    std::unique_lock<std::mutex> l(signal_->lock_);
+    signal_->available_++;
+    signal_->cv_.notify_one();
+}
+
+bool Test::StreamConsumer::WaitBufferAvailable()
+{
+    std::unique_lock<std::mutex> l(signal_->lock_);
+    signal_->cv_.wait(l, [this] { return signal_->available_ > 0 || signal_->stopped_; });
+    if (signal_->stopped_) {
+        return false;
+    }
+    signal_->available_--;
+    return true;
+}
+
+void Test::StreamConsumer::RecordArrival()
+{
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    arrivals_.push_back(static_cast<uint64_t>(now.count()));
+    arrivalCv_.notify_all();
+}
+
+void Test::StreamConsumer::ResetArrivals()
+{
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    arrivals_.clear();
+}
+
+uint64_t Test::StreamConsumer::WaitFirstArrival(uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    if (!arrivalCv_.wait_for(l, std::chrono::milliseconds(timeoutMs), [this] { return !arrivals_.empty(); })) {
+        return 0;
+    }
+    return arrivals_.front();
+}
+
+size_t Test::StreamConsumer::ArrivalCount()
+{
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    return arrivals_.size();
+}
+
+bool Test::StreamConsumer::WaitArrivals(size_t count, uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    return arrivalCv_.wait_for(l, std::chrono::milliseconds(timeoutMs), [this, count] {
+        return arrivals_.size() >= count;
+    });
+}
+
+std::vector<uint64_t> Test::StreamConsumer::GetArrivals()
+{
+    std::unique_lock<std::mutex> l(arrivalLock_);
+    return arrivals_;
+}
+
 void Test::StreamConsumer::StopConsumer()
 {
+    std::unique_lock<std::mutex> l(signal_->lock_);
     running_ = false;
+    signal_->stopped_ = true;
+    signal_->cv_.notify_all();
 }
 }
@@ -26,10 +26,14 @@
 #include <sys/ioctl.h>
 #include <sys/wait.h>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <stdio.h>
 #include <sys/time.h>
 #include <vector>
 #include <map>
+#include <deque>
 #include "utils.h"
 #include "camera.h"
 #include "camera_host.h"
@@ -72,6 +76,8 @@ public:
     void CreateDeviceCallback();
     void CreateOfflineStreamOperatorCallback();
     void StreamInfoFormat();
+    void ResetFramePacing();
+    void ReportFramePacing();
 
     OHOS::sptr<StreamOperatorCallback> streamOperatorCallback = nullptr;
     OHOS::sptr<CameraHostCallback> hostCallback = nullptr;
@@ -99,6 +105,8 @@ public:
     std::vector<int> captureIds;
     std::vector<int> streamIds;
     std::vector<Camera::StreamIntent> intents;
+    // minFrameDuration_ StartStream requests for preview and video, in nanoseconds; 0 leaves the rate to the HAL
+    int32_t minFrameDuration = 0;
     OHOS::Camera::CamRetCode rc;
 
 #ifdef CAMERA_BUILT_ON_OHOS_LITE
@@ -111,24 +119,74 @@ public:
     std::shared_ptr<CameraAbility> ability = nullptr;
 
     bool status;
-    bool onCameraStatusFlag;
-    bool onFlashlightStatusFlag;
-    bool onErrorFlag;
-    bool onResultFlag;
-    bool captureStartFlag;
-    bool captureEndFlag;
-    bool captureErrorFlag;
-    bool frameShutterFlag;
+
+    // callbacks signal these, tests wait on them instead of sleeping and checking a flag afterwards
+    enum CameraEvent {
+        EVENT_CAMERA_STATUS = 0,
+        EVENT_FLASHLIGHT_STATUS,
+        EVENT_DEVICE_ERROR,
+        EVENT_RESULT,
+        EVENT_CAPTURE_STARTED,
+        EVENT_CAPTURE_ENDED,
+        EVENT_CAPTURE_ERROR,
+        EVENT_FRAME_SHUTTER,
+        EVENT_COUNT,
+    };
+    static constexpr uint32_t EVENT_TIMEOUT_MS = 3000; // 3000:upper bound only, waits end with the event
+    struct Event {
+        std::atomic<bool> signalled_ = false;
+        std::mutex lock_;
+        std::condition_variable cv_;
+    };
+    Event events_[EVENT_COUNT];
+    void SignalEvent(CameraEvent event);
+    void ResetEvent(CameraEvent event);
+    bool EventSignalled(CameraEvent event);
+    // true as soon as the event is signalled, false if the timeout passes first
+    bool WaitEvent(CameraEvent event, uint32_t timeoutMs);
+    // waits for count buffers on the stream beyond those already received
+    bool WaitBuffers(int streamId, uint32_t count, uint32_t timeoutMs);
     int previewBufCnt = 0;
     int32_t videoFd = -1;
     class StreamConsumer;
     std::map<OHOS::Camera::StreamIntent, std::shared_ptr<StreamConsumer>> consumerMap_ = {};
+    std::shared_ptr<StreamConsumer> StreamConsumerOf(int streamId);
+    // minFrameDuration_ each intent was created with, in nanoseconds; 0 leaves the rate to the HAL
+    std::map<OHOS::Camera::StreamIntent, uint64_t> frameDurationMap_ = {};
+
+    // buffer arrival statistics of one stream, measured against the frame duration it requested
+    struct FramePacing {
+        static constexpr uint64_t DEFAULT_INTERVAL_NS = 33333333; // 33333333:30 fps when the HAL picks the rate
+        static constexpr uint32_t BUCKETS_PER_INTERVAL = 4;
+        static constexpr uint32_t HISTOGRAM_INTERVALS = 4;
+        uint64_t frames = 0;
+        uint64_t expectedIntervalNs = 0;
+        bool requested = false; // false when expectedIntervalNs is only DEFAULT_INTERVAL_NS standing in for the HAL
+        uint64_t minIntervalNs = 0;
+        uint64_t maxIntervalNs = 0;
+        uint64_t meanIntervalNs = 0;
+        double fps = 0;
+        uint64_t droppedFrames = 0; // frame slots missed by intervals longer than the expected one
+        // counts of intervals by quarter of the expected interval, the last bucket holds anything longer
+        std::vector<uint64_t> histogram;
+    };
+    FramePacing GetFramePacing(OHOS::Camera::StreamIntent intent);
+
+    // counts buffers queued to a consumer surface; shared so the surface may outlive the StreamConsumer
+    struct BufferSignal {
+        std::mutex lock_;
+        std::condition_variable cv_;
+        uint32_t available_ = 0;
+        bool stopped_ = false;
+    };
 
     class TestBufferConsumerListener : public IBufferConsumerListener {
     public:
-        TestBufferConsumerListener() {}
+        explicit TestBufferConsumerListener(const std::shared_ptr<BufferSignal> &signal) : signal_(signal) {}
         ~TestBufferConsumerListener() {}
-        void OnBufferAvailable() {}
+        void OnBufferAvailable();
+    private:
+        std::shared_ptr<BufferSignal> signal_;
     };
 
     class StreamConsumer {
@@ -149,9 +207,18 @@ public:
             std::unique_lock<std::mutex> l(l_);
             cv_.wait(l, [this]() { return shotCount_ == 0; });
         }
+        // blocks until the surface reports a queued buffer; false once the consumer is stopped
+        bool WaitBufferAvailable();
+        void RecordArrival();
+        void ResetArrivals();
+        // steady clock nanoseconds of the first recorded buffer, 0 if none arrived within the timeout
+        uint64_t WaitFirstArrival(uint32_t timeoutMs);
+        size_t ArrivalCount();
+        bool WaitArrivals(size_t count, uint32_t timeoutMs);
+        std::vector<uint64_t> GetArrivals();
         ~StreamConsumer()
         {
-            running_ = false;
+            StopConsumer();
             if (consumerThread_ != nullptr) {
                 consumerThread_->join();
                 delete consumerThread_;
@@ -162,6 +229,7 @@ public:
         std::mutex l_;
         std::condition_variable cv_;
         bool running_ = true;
+        std::shared_ptr<BufferSignal> signal_ = std::make_shared<BufferSignal>();
 #ifdef CAMERA_BUILT_ON_OHOS_LITE
         std::shared_ptr<OHOS::Surface> consumer_ = nullptr;
         std::function<void(OHOS::SurfaceBuffer*)> callback_ = nullptr;
@@ -170,7 +238,50 @@ public:
         std::function<void(void*, uint32_t)> callback_ = nullptr;
 #endif
         std::thread* consumerThread_ = nullptr;
+        std::mutex arrivalLock_;
+        std::condition_variable arrivalCv_;
+        std::vector<uint64_t> arrivals_; // steady clock nanoseconds of every acquired buffer
+    };
+
+    // writes saved frames on its own thread so consumers never wait on storage; a frame that finds every
+    // slot busy is dropped and counted instead of blocking the HAL
+    class FrameDumper {
+    public:
+        static constexpr uint32_t QUEUE_DEPTH = 8;
+        ~FrameDumper();
+        int32_t Enqueue(const char* type, const void* buffer, int32_t size);
+        void Flush();
+        uint64_t WrittenCount() const
+        {
+            return written_;
+        }
+        uint64_t DroppedCount() const
+        {
+            return dropped_;
+        }
+    private:
+        struct Frame {
+            std::string type;
+            std::vector<uint8_t> data; // keeps its capacity across reuses of the slot
+        };
+        void WriteLoop();
+        int OpenOutput(const std::string& type);
+        int OutputFd(const std::string& type);
+        std::mutex lock_;
+        std::condition_variable cv_;
+        std::condition_variable idleCv_;
+        std::vector<std::unique_ptr<Frame>> slots_;
+        std::vector<Frame*> free_;
+        std::deque<Frame*> queue_;
+        std::map<std::string, int> fds_;
+        std::thread* writer_ = nullptr;
+        bool stopping_ = false;
+        bool writing_ = false;
+        uint64_t stills_ = 0; // touched by the writer thread only
+        std::atomic<uint64_t> written_ = 0;
+        std::atomic<uint64_t> dropped_ = 0;
     };
+    std::shared_ptr<FrameDumper> frameDumper_ = std::make_shared<FrameDumper>();
 };
 
 class HdiHostCallback : public CameraHostCallback {
@@ -183,11 +294,11 @@ public:
     }
     virtual void OnCameraStatus(const std::string &cameraId, CameraStatus status) override
     {
-        test_->onCameraStatusFlag = true;
+        test_->SignalEvent(Test::EVENT_CAMERA_STATUS);
     }
     virtual void OnFlashlightStatus(const std::string &cameraId, FlashlightStatus status) override
     {
-        test_->onFlashlightStatusFlag = true;
+        test_->SignalEvent(Test::EVENT_FLASHLIGHT_STATUS);
     }
 };
 class HdiDeviceCallback : public CameraDeviceCallback {
@@ -200,11 +311,11 @@ public:
     }
     virtual void OnError(ErrorType type, int32_t errorMsg) override
     {
-        test_->onErrorFlag = true;
+        test_->SignalEvent(Test::EVENT_DEVICE_ERROR);
     }
     virtual void OnResult(uint64_t timestamp, const std::shared_ptr<Camera::CameraMetadata> &result) override
     {
-        test_->onResultFlag = true;
+        test_->SignalEvent(Test::EVENT_RESULT);
     }
 };
 class HdiOperatorCallback : public StreamOperatorCallback {
@@ -217,22 +328,22 @@ public:
     }
     virtual void OnCaptureStarted(int32_t captureId, const std::vector<int32_t> &streamId) override
     {
-        test_->captureStartFlag = true;
+        test_->SignalEvent(Test::EVENT_CAPTURE_STARTED);
     }
     virtual void OnCaptureEnded(int32_t captureId,
         const std::vector<std::shared_ptr<CaptureEndedInfo>> &info) override
     {
-        test_->captureEndFlag = true;
+        test_->SignalEvent(Test::EVENT_CAPTURE_ENDED);
     }
     virtual void OnCaptureError(int32_t captureId,
         const std::vector<std::shared_ptr<CaptureErrorInfo>> &info) override
     {
-        test_->captureErrorFlag = true;
+        test_->SignalEvent(Test::EVENT_CAPTURE_ERROR);
     }
     virtual void OnFrameShutter(int32_t captureId,
         const std::vector<int32_t> &streamId, uint64_t timestamp) override
     {
-        test_->frameShutterFlag = true;
+        test_->SignalEvent(Test::EVENT_FRAME_SHUTTER);
     }
 };
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STARTUP_LATENCY_TEST_H
+#define STARTUP_LATENCY_TEST_H
+
+#include "common.h"
+
+enum StartupPhase {
+    STARTUP_GET_HOST = 0,      // cold runs only: acquire the host and register its callback
+    STARTUP_OPEN_CAMERA,
+    STARTUP_GET_ABILITY,
+    STARTUP_GET_STREAM_OPERATOR,
+    STARTUP_CREATE_STREAMS,
+    STARTUP_COMMIT_STREAMS,
+    STARTUP_CAPTURE,
+    STARTUP_FIRST_PREVIEW,     // preview Capture call to the first preview buffer
+    STARTUP_FIRST_VIDEO,       // video Capture call to the first video buffer
+    STARTUP_PHASE_COUNT,
+};
+
+struct StartupSample {
+    uint64_t phaseNs[STARTUP_PHASE_COUNT] = {0};
+    uint64_t totalNs = 0;      // start of the run to the last first buffer
+    bool complete = false;
+};
+
+class StartupLatencyTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp(void);
+    void TearDown(void);
+    bool RunStartup(bool cold, StartupSample& sample);
+    void StopStartup();
+    void ReportStartup(const char* name, const std::vector<StartupSample>& samples);
+    std::shared_ptr<OHOS::Camera::Test> Test_ = nullptr;
+};
+#endif